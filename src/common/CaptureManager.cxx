@@ -0,0 +1,366 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <chrono>
+
+#include "OSystem.hxx"
+#include "Console.hxx"
+#include "FrameBuffer.hxx"
+#include "FSNode.hxx"
+#include "PNGLibrary.hxx"
+#include "Props.hxx"
+#include "Settings.hxx"
+#include "TIA.hxx"
+
+#include "CaptureManager.hxx"
+
+// The rate of the recorded sound
+static constexpr uInt32 SAMPLE_RATE = 31400;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CaptureManager::CaptureManager(OSystem& system)
+  : myOSystem(system),
+    myRecording(false),
+    myQueueHead(0),
+    myQueueTail(0),
+    myStopEncoder(false),
+    myFrameCount(0),
+    mySampleCount(0),
+    myTIASound(SAMPLE_RATE),
+    myAudioCycle(0),
+    mySampleFraction(0.0),
+    myFrameCycle(0),
+    myCyclesPerSecond(0.0),
+    myStopSnapshots(false)
+{
+  memset(myPalette, 0, sizeof(myPalette));
+  myTIASound.channels(1, false);
+  myTIASound.volume(100);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CaptureManager::~CaptureManager()
+{
+  stopRecording();
+
+  // Write the pending snapshots before exiting
+  if(mySnapshotEncoder.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(mySnapshotMutex);
+      myStopSnapshots = true;
+    }
+    mySnapshotCondition.notify_all();
+    mySnapshotEncoder.join();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::toggleRecording()
+{
+  if(myRecording)
+  {
+    uInt32 frames = stopRecording();
+    myOSystem.frameBuffer().showMessage("Recording stopped (" +
+        std::to_string(frames) + " frames)");
+  }
+  else if(startRecording())
+    myOSystem.frameBuffer().showMessage("Recording to " + myDirectory);
+  else
+    myOSystem.frameBuffer().showMessage("Recording failed");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CaptureManager::startRecording()
+{
+  if(myRecording || !myOSystem.hasConsole())
+    return myRecording;
+
+  // Each recording goes into a new directory, named like the snapshots
+  string path = myOSystem.snapshotSaveDir() +
+      (myOSystem.settings().getString("snapname") != "int" ?
+          myOSystem.romFile().getNameWithExt("")
+        : myOSystem.console().properties().get(Cartridge_Name)) + "_capture";
+  FilesystemNode node(path);
+  for(uInt32 i = 1; node.exists(); ++i)
+    node = FilesystemNode(path + "_" + std::to_string(i));
+  if(!node.makeDir())
+    return false;
+  myDirectory = node.getPath() + BSPF::PATH_SEPARATOR;
+
+  myWAVFile.open(myDirectory + "audio.wav", std::ios_base::binary);
+  if(!myWAVFile.is_open())
+    return false;
+  writeWAVHeader(0);
+
+  if(!myQueue)
+    myQueue = make_unique<Frame[]>(QUEUE_SIZE);
+  myQueueHead = myQueueTail = 0;
+  myFrameCount = mySampleCount = 0;
+
+  // Start the sound from the current state of the audio registers
+  TIA& tia = myOSystem.console().tia();
+  myTIASound.reset();
+  myAudioCycle = tia.cycles();
+  mySampleFraction = 0.0;
+  myFrameCycle = myAudioCycle;
+  myCyclesPerSecond = 0.0;
+  myAudioWrites.clear();
+  for(uInt16 address = AUDC0; address <= AUDV1; ++address)
+    addAudioWrite(address, tia.registerValue(address), myAudioCycle);
+
+  tia.setAudioWriteCallback([this](uInt16 address, uInt8 value, uInt64 cycle) {
+    addAudioWrite(address, value, cycle);
+  });
+
+  myStopEncoder = false;
+  myEncoder = std::thread(&CaptureManager::encodeFrames, this);
+  myRecording = true;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 CaptureManager::stopRecording()
+{
+  if(!myRecording)
+    return 0;
+
+  if(myOSystem.hasConsole())
+    myOSystem.console().tia().setAudioWriteCallback(nullptr);
+
+  // The encoder finishes the queued frames before it exits
+  myStopEncoder = true;
+  myEncoder.join();
+
+  writeWAVHeader(mySampleCount);
+  myWAVFile.close();
+  myRecording = false;
+
+  return myFrameCount;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::setPalette(const uInt32* palette)
+{
+  memcpy(myPalette, palette, sizeof(myPalette));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::addFrame(const TIA& tia)
+{
+  if(!myRecording)
+    return;
+
+  // Wait for the encoder to make room in the queue
+  uInt32 head = myQueueHead.load(std::memory_order_relaxed);
+  while(head - myQueueTail.load(std::memory_order_acquire) >= QUEUE_SIZE)
+    std::this_thread::yield();
+
+  Frame& frame = myQueue[head % QUEUE_SIZE];
+  frame.height = std::min(tia.height(), TIAConstants::frameBufferHeight);
+  memcpy(frame.pixels, tia.frameBuffer(), 160 * frame.height);
+  memcpy(frame.palette, myPalette, sizeof(myPalette));
+  frame.cycle = tia.cycles();
+  frame.framerate = myOSystem.console().getFramerate();
+
+  // Hand over the audio writes, and reuse the storage of the old ones
+  frame.audio.clear();
+  frame.audio.swap(myAudioWrites);
+
+  myQueueHead.store(head + 1, std::memory_order_release);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::saveSnapshot(const TIA& tia, const string& filename,
+                                  const VariantList& comments)
+{
+  unique_ptr<Snapshot> snapshot = make_unique<Snapshot>();
+  snapshot->filename = filename;
+  snapshot->comments = comments;
+  snapshot->height = std::min(tia.height(), TIAConstants::frameBufferHeight);
+  memcpy(snapshot->pixels, tia.frameBuffer(), 160 * snapshot->height);
+  memcpy(snapshot->palette, myPalette, sizeof(myPalette));
+
+  if(!mySnapshotEncoder.joinable())
+    mySnapshotEncoder = std::thread(&CaptureManager::encodeSnapshots, this);
+
+  std::unique_lock<std::mutex> lock(mySnapshotMutex);
+  mySnapshotCondition.wait(lock, [this] {
+    return mySnapshots.size() < SNAPSHOT_QUEUE_SIZE;
+  });
+  mySnapshots.push_back(std::move(snapshot));
+  lock.unlock();
+  mySnapshotCondition.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::addAudioWrite(uInt16 address, uInt8 value, uInt64 cycle)
+{
+  myAudioWrites.push_back({cycle, address, value});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::encodeFrames()
+{
+  for(;;)
+  {
+    // Check the stop request first, so frames queued before it aren't lost
+    bool stop = myStopEncoder;
+    uInt32 tail = myQueueTail.load(std::memory_order_relaxed);
+    if(tail == myQueueHead.load(std::memory_order_acquire))
+    {
+      if(stop)
+        break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+
+    encodeFrame(myQueue[tail % QUEUE_SIZE]);
+    myQueueTail.store(tail + 1, std::memory_order_release);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::encodeFrame(const Frame& frame)
+{
+  ostringstream filename;
+  filename << myDirectory << "frame_" << std::setw(6) << std::setfill('0')
+           << myFrameCount++ << ".png";
+  try
+  {
+    // TIA pixels are twice as wide as they are high
+    PNGLibrary::saveImage(filename.str(), frame.pixels, 160, frame.height,
+                          frame.palette, 2);
+  }
+  catch(const runtime_error& e)
+  {
+    cerr << "ERROR: recording frame '" << filename.str() << "': "
+         << e.what() << endl;
+  }
+
+  // The emulation runs a frame of (scanlines * 76) cycles per 1/framerate
+  // second, rather than at the CPU clock of a real console; the sound of
+  // each frame must last as long as the frame is shown
+  if(frame.cycle > myFrameCycle)
+    myCyclesPerSecond = (frame.cycle - myFrameCycle) * double(frame.framerate);
+  myFrameCycle = frame.cycle;
+
+  for(const AudioWrite& write: frame.audio)
+  {
+    generateSamples(write.cycle);
+    myTIASound.set(write.address, write.value);
+  }
+  generateSamples(frame.cycle);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::generateSamples(uInt64 cycle)
+{
+  // Loading a state may move the cycles backwards, or far ahead; the
+  // sound then simply continues from there
+  if(cycle < myAudioCycle || cycle - myAudioCycle >= myCyclesPerSecond)
+  {
+    myAudioCycle = cycle;
+    return;
+  }
+
+  double samples = (cycle - myAudioCycle) * SAMPLE_RATE / myCyclesPerSecond +
+                   mySampleFraction;
+  uInt32 count = uInt32(samples);
+  mySampleFraction = samples - count;
+  myAudioCycle = cycle;
+  if(count == 0)
+    return;
+
+  mySamples.resize(count);
+  myTIASound.process(mySamples.data(), count);
+
+  // WAV files are always little-endian
+  for(Int16 sample: mySamples)
+  {
+    myWAVFile.put(char(sample & 0xff));
+    myWAVFile.put(char((sample >> 8) & 0xff));
+  }
+  mySampleCount += count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::writeWAVHeader(uInt32 samples)
+{
+  const auto put32 = [this](uInt32 v) {
+    for(int i = 0; i < 4; ++i, v >>= 8)
+      myWAVFile.put(char(v & 0xff));
+  };
+  const auto put16 = [this](uInt16 v) {
+    myWAVFile.put(char(v & 0xff));
+    myWAVFile.put(char(v >> 8));
+  };
+
+  // Mono, 16-bit PCM
+  myWAVFile.seekp(0);
+  myWAVFile.write("RIFF", 4);  put32(36 + samples * 2);
+  myWAVFile.write("WAVE", 4);
+  myWAVFile.write("fmt ", 4);  put32(16);
+  put16(1);                 // PCM
+  put16(1);                 // channels
+  put32(SAMPLE_RATE);
+  put32(SAMPLE_RATE * 2);   // bytes per second
+  put16(2);                 // bytes per sample
+  put16(16);                // bits per sample
+  myWAVFile.write("data", 4);  put32(samples * 2);
+  myWAVFile.seekp(0, std::ios_base::end);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CaptureManager::encodeSnapshots()
+{
+  BytePtr pixels = make_unique<uInt8[]>(320 * TIAConstants::frameBufferHeight);
+
+  for(;;)
+  {
+    unique_ptr<Snapshot> snapshot;
+    {
+      std::unique_lock<std::mutex> lock(mySnapshotMutex);
+      mySnapshotCondition.wait(lock, [this] {
+        return !mySnapshots.empty() || myStopSnapshots;
+      });
+      if(mySnapshots.empty())
+        break;
+      snapshot = std::move(mySnapshots.front());
+      mySnapshots.pop_front();
+    }
+    mySnapshotCondition.notify_all();
+
+    // Double each pixel, as in the 1x snapshots taken from the screen
+    const uInt8* src = snapshot->pixels;
+    uInt8* dst = pixels.get();
+    for(uInt32 i = 0; i < 160 * snapshot->height; ++i, dst += 2)
+      dst[0] = dst[1] = src[i];
+
+    try
+    {
+      PNGLibrary::saveImage(snapshot->filename, pixels.get(), 320,
+          snapshot->height, snapshot->palette, 1, snapshot->comments);
+    }
+    catch(const runtime_error& e)
+    {
+      cerr << "ERROR: saving snapshot '" << snapshot->filename << "': "
+           << e.what() << endl;
+    }
+  }
+}
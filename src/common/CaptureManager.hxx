@@ -0,0 +1,227 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef CAPTURE_MANAGER_HXX
+#define CAPTURE_MANAGER_HXX
+
+class OSystem;
+class TIA;
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "TIAConstants.hxx"
+#include "TIASnd.hxx"
+#include "Variant.hxx"
+#include "bspf.hxx"
+
+/**
+  This class records the emulation into a directory, as a PNG image for
+  each frame and a WAV file for the sound.
+
+  The emulation only copies the raw TIA frame buffer, the palette and the
+  writes to the audio registers into a queue.  A separate thread takes the
+  frames from the queue, encodes them, and generates the sound from the
+  register writes (so sound is recorded even if it is disabled, and in
+  sync with the frames no matter how fast the emulation runs).  When the
+  queue is full, the emulation waits for the encoder, so no frame is
+  ever dropped.
+
+  Continuous snapshots are taken the same way, from the raw TIA frame and
+  encoded on their own thread, so they don't interrupt the emulation.
+*/
+class CaptureManager
+{
+  public:
+    CaptureManager(OSystem& system);
+    ~CaptureManager();
+
+  public:
+    /**
+      Start/stop recording the current console, showing a message.
+    */
+    void toggleRecording();
+
+    /**
+      Start recording the current console into a new directory.
+
+      @return  Whether recording has started
+    */
+    bool startRecording();
+
+    /**
+      Stop recording, after all queued frames have been encoded.
+
+      @return  The number of frames recorded
+    */
+    uInt32 stopRecording();
+
+    /**
+      Answers whether frames are being recorded.
+    */
+    bool isRecording() const { return myRecording; }
+
+    /**
+      Set the RGB palette used for the following frames.
+
+      @param palette  256 RGB values (0x00RRGGBB)
+    */
+    void setPalette(const uInt32* palette);
+
+    /**
+      Queue the frame which the TIA just finished, along with the audio
+      register writes which happened since the previous frame.  This waits
+      while the queue is full.
+
+      @param tia  The TIA which generated the frame
+    */
+    void addFrame(const TIA& tia);
+
+    /**
+      Save the current TIA frame to a PNG image, scaled 2x horizontally.
+      The frame is only copied here; the image is written on a separate
+      thread.  This waits while too many snapshots are still pending.
+
+      @param tia       The TIA which generated the frame
+      @param filename  The filename to save the PNG image
+      @param comments  The text comments to add to the PNG image
+    */
+    void saveSnapshot(const TIA& tia, const string& filename,
+                      const VariantList& comments);
+
+  private:
+    // A write to one of the TIA audio registers
+    struct AudioWrite {
+      uInt64 cycle;
+      uInt16 address;
+      uInt8 value;
+    };
+
+    // Everything needed to encode one frame
+    struct Frame {
+      uInt8 pixels[160 * TIAConstants::frameBufferHeight];
+      uInt32 height;
+      uInt32 palette[256];
+      uInt64 cycle;  // system cycles at the end of the frame
+      float framerate;  // the framerate the frame is shown at
+      vector<AudioWrite> audio;
+    };
+
+    // A snapshot waiting to be written
+    struct Snapshot {
+      string filename;
+      VariantList comments;
+      uInt8 pixels[160 * TIAConstants::frameBufferHeight];
+      uInt32 height;
+      uInt32 palette[256];
+    };
+
+    // Number of frames/snapshots which can be queued
+    static constexpr uInt32 QUEUE_SIZE = 64;
+    static constexpr uInt32 SNAPSHOT_QUEUE_SIZE = 4;
+
+    /**
+      Record a write to an audio register.
+    */
+    void addAudioWrite(uInt16 address, uInt8 value, uInt64 cycle);
+
+    /**
+      The encoder thread; encodes queued frames until recording stops.
+    */
+    void encodeFrames();
+
+    /**
+      Write the PNG image and sound samples of the given frame.
+    */
+    void encodeFrame(const Frame& frame);
+
+    /**
+      Generate and write the sound samples up to the given system cycle.
+    */
+    void generateSamples(uInt64 cycle);
+
+    /**
+      Write/update the header of the WAV file for the given number of samples.
+    */
+    void writeWAVHeader(uInt32 samples);
+
+    /**
+      The snapshot thread; writes queued snapshots until told to stop.
+    */
+    void encodeSnapshots();
+
+  private:
+    // The parent system for the manager
+    OSystem& myOSystem;
+
+    // Whether recording is active
+    bool myRecording;
+
+    // The queue of frames; myQueueHead is only advanced by the emulation,
+    // and myQueueTail only by the encoder
+    unique_ptr<Frame[]> myQueue;
+    std::atomic<uInt32> myQueueHead;
+    std::atomic<uInt32> myQueueTail;
+
+    // The current palette, and the audio writes of the frame being emulated
+    uInt32 myPalette[256];
+    vector<AudioWrite> myAudioWrites;
+
+    // The encoder, and the request to stop it once the queue is empty
+    std::thread myEncoder;
+    std::atomic<bool> myStopEncoder;
+
+    // Where to save the recording, and how much has been recorded so far
+    string myDirectory;
+    uInt32 myFrameCount;
+    ofstream myWAVFile;
+    uInt32 mySampleCount;
+
+    // Generates the sound from the register writes
+    TIASound myTIASound;
+    vector<Int16> mySamples;
+
+    // The cycle up to which sound has been generated, and the fraction
+    // of a sample left over from it
+    uInt64 myAudioCycle;
+    double mySampleFraction;
+
+    // The cycle at which the last frame ended, and the system cycles per
+    // second of the recording as of that frame
+    uInt64 myFrameCycle;
+    double myCyclesPerSecond;
+
+    // The pending snapshots, and the thread which writes them
+    std::deque<unique_ptr<Snapshot>> mySnapshots;
+    std::mutex mySnapshotMutex;
+    std::condition_variable mySnapshotCondition;
+    std::thread mySnapshotEncoder;
+    bool myStopSnapshots;
+
+  private:
+    // Following constructors and assignment operators not supported
+    CaptureManager() = delete;
+    CaptureManager(const CaptureManager&) = delete;
+    CaptureManager(CaptureManager&&) = delete;
+    CaptureManager& operator=(const CaptureManager&) = delete;
+    CaptureManager& operator=(CaptureManager&&) = delete;
+};
+
+#endif
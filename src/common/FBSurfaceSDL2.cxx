@@ -24,6 +24,7 @@ FBSurfaceSDL2::FBSurfaceSDL2(FrameBufferSDL2& buffer,
     mySurface(nullptr),
     myTexture(nullptr),
     mySurfaceIsDirty(true),
+    myRowsAreDirty(false),
     myIsVisible(true),
     myTexAccess(SDL_TEXTUREACCESS_STREAMING),
     myInterpolate(false),
@@ -126,20 +127,54 @@ void FBSurfaceSDL2::translateCoords(Int32& x, Int32& y) const
   y -= myDstR.y;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::setDirtyRows(uInt32 y, uInt32 h)
+{
+  myRowsAreDirty = true;
+  if(h == 0)
+    return;
+
+  // Rows adjacent to the previous range are merged into it
+  if(!myDirtyRows.empty() &&
+     uInt32(myDirtyRows.back().y + myDirtyRows.back().h) == y)
+    myDirtyRows.back().h += h;
+  else
+    myDirtyRows.push_back(SDL_Rect{ 0, int(y), 0, int(h) });
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FBSurfaceSDL2::render()
 {
-  if(mySurfaceIsDirty && myIsVisible)
+  if((mySurfaceIsDirty || myRowsAreDirty) && myIsVisible)
   {
 //cerr << "src: x=" << mySrcR.x << ", y=" << mySrcR.y << ", w=" << mySrcR.w << ", h=" << mySrcR.h << endl;
 //cerr << "dst: x=" << myDstR.x << ", y=" << myDstR.y << ", w=" << myDstR.w << ", h=" << myDstR.h << endl;
 
 //cerr << "render()\n";
     if(myTexAccess == SDL_TEXTUREACCESS_STREAMING)
-      SDL_UpdateTexture(myTexture, &mySrcR, mySurface->pixels, mySurface->pitch);
+    {
+      if(mySurfaceIsDirty)
+        SDL_UpdateTexture(myTexture, &mySrcR, mySurface->pixels, mySurface->pitch);
+      else
+      {
+        // Only transfer the modified rows (relative to the source rect)
+        for(const SDL_Rect& rows: myDirtyRows)
+        {
+          if(rows.y >= mySrcR.h)
+            continue;
+
+          SDL_Rect rect = mySrcR;
+          rect.y += rows.y;
+          rect.h = std::min(rows.h, mySrcR.h - rows.y);
+          SDL_UpdateTexture(myTexture, &rect, static_cast<uInt8*>(mySurface->pixels) +
+                            rows.y * mySurface->pitch, mySurface->pitch);
+        }
+      }
+    }
     SDL_RenderCopy(myFB.myRenderer, myTexture, &mySrcR, &myDstR);
 
-    mySurfaceIsDirty = false;
+    mySurfaceIsDirty = myRowsAreDirty = false;
+    myDirtyRows.clear();
 
     // Let postFrameUpdate() know that a change has been made
     return myFB.myDirtyFlag = true;
@@ -174,6 +209,9 @@ void FBSurfaceSDL2::reload()
   // If the data is static, we only upload it once
   if(myTexAccess == SDL_TEXTUREACCESS_STATIC)
     SDL_UpdateTexture(myTexture, nullptr, myStaticData, myStaticPitch);
+  // Otherwise the new texture is empty, and must be updated in full
+  else
+    mySurfaceIsDirty = true;
 
   // Blending enabled?
   if(myBlendEnabled)
@@ -41,6 +41,7 @@ class FBSurfaceSDL2 : public FBSurface
     void fillRect(uInt32 x, uInt32 y, uInt32 w, uInt32 h, uInt32 color) override;
     // With hardware surfaces, it's faster to just update the entire surface
     void setDirty() override { mySurfaceIsDirty = true; }
+    void setDirtyRows(uInt32 y, uInt32 h) override;
 
     uInt32 width() const override;
     uInt32 height() const override;
@@ -81,6 +82,8 @@ class FBSurfaceSDL2 : public FBSurface
     SDL_Rect mySrcR, myDstR;
 
     bool mySurfaceIsDirty;
+    bool myRowsAreDirty;            // Only myDirtyRows need to be updated
+    vector<SDL_Rect> myDirtyRows;
     bool myIsVisible;
 
     SDL_TextureAccess myTexAccess;  // Is pixel data constant or can it change?
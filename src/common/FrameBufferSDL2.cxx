@@ -33,7 +33,8 @@ FrameBufferSDL2::FrameBufferSDL2(OSystem& osystem)
   : FrameBuffer(osystem),
     myWindow(nullptr),
     myRenderer(nullptr),
-    myDirtyFlag(true)
+    myDirtyFlag(true),
+    myVsync(false)
 {
   // Initialize SDL2 context
   if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_JOYSTICK) < 0)
@@ -202,9 +203,16 @@ bool FrameBufferSDL2::setVideoMode(const string& title, const VideoMode& mode)
     return false;
   }
   SDL_RendererInfo renderinfo;
+  myVsync = false;
   if(SDL_GetRendererInfo(myRenderer, &renderinfo) >= 0)
+  {
     myOSystem.settings().setValue("video", renderinfo.name);
 
+    // The driver may not honour the vsync request
+    myVsync = renderinfo.flags & SDL_RENDERER_PRESENTVSYNC;
+  }
+  myVsyncTime = 0;
+
   return true;
 }
 
@@ -257,6 +265,14 @@ bool FrameBufferSDL2::fullScreen() const
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FrameBufferSDL2::windowVisible() const
+{
+  // SDL keeps these flags up to date from the window events
+  return myWindow &&
+      !(SDL_GetWindowFlags(myWindow) & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FrameBufferSDL2::postFrameUpdate()
 {
@@ -265,6 +281,10 @@ void FrameBufferSDL2::postFrameUpdate()
     // Now show all changes made to the renderer
     SDL_RenderPresent(myRenderer);
     myDirtyFlag = false;
+
+    // A vsync'ed present returns once the display has refreshed
+    if(myVsync)
+      myVsyncTime = myOSystem.getTicks();
   }
 }
 
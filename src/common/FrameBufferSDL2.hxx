@@ -62,6 +62,12 @@ class FrameBufferSDL2 : public FrameBuffer
     */
     bool fullScreen() const override;
 
+    /**
+      Answers if the window can currently be seen (ie, it isn't hidden
+      or minimized).
+    */
+    bool windowVisible() const override;
+
     /**
       This method is called to retrieve the R/G/B data from the given pixel.
 
@@ -177,6 +183,9 @@ class FrameBufferSDL2 : public FrameBuffer
     // Indicates that the renderer has been modified, and should be redrawn
     bool myDirtyFlag;
 
+    // Whether presenting the renderer waits for the display refresh
+    bool myVsync;
+
   private:
     // Following constructors and assignment operators not supported
     FrameBufferSDL2() = delete;
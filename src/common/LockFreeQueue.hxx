@@ -0,0 +1,96 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef LOCK_FREE_QUEUE_HXX
+#define LOCK_FREE_QUEUE_HXX
+
+#include <array>
+#include <atomic>
+
+#include "bspf.hxx"
+
+/**
+ * Fixed size queue, passing items from one thread (the producer) to
+ * another (the consumer) without locking.  It never allocates; when it
+ * is full, writing adds as many items as fit.
+ */
+namespace Common {
+
+template <class T, uInt32 CAPACITY>
+class LockFreeQueue
+{
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0,
+                "LockFreeQueue capacity must be a power of two");
+
+  private:
+    array<T, CAPACITY> _buffer;
+
+    // Only advanced by the consumer and the producer, respectively;
+    // both keep counting past the capacity, and wrap around when indexing
+    std::atomic<uInt32> _head;
+    std::atomic<uInt32> _tail;
+
+  public:
+    LockFreeQueue<T, CAPACITY>() : _head(0), _tail(0) { }
+
+    // Remove all items; only while neither thread accesses the queue
+    void clear() { _head = _tail = 0; }
+
+    // Number of items in the queue, and the room left (exact for the
+    // consumer and the producer, respectively)
+    uInt32 size() const {
+      return _tail.load(std::memory_order_acquire) -
+             _head.load(std::memory_order_relaxed);
+    }
+    uInt32 space() const {
+      return CAPACITY - (_tail.load(std::memory_order_relaxed) -
+                         _head.load(std::memory_order_acquire));
+    }
+
+    // Add up to 'count' items (producer only), returning how many were added
+    uInt32 write(const T* items, uInt32 count) {
+      const uInt32 tail = _tail.load(std::memory_order_relaxed);
+      count = std::min(count, space());
+      for(uInt32 i = 0; i < count; ++i)
+        _buffer[(tail + i) & (CAPACITY - 1)] = items[i];
+      _tail.store(tail + count, std::memory_order_release);
+      return count;
+    }
+
+    // Remove up to 'count' items (consumer only) into the given array, or
+    // drop them if it's nullptr, returning how many were removed
+    uInt32 read(T* items, uInt32 count) {
+      const uInt32 head = _head.load(std::memory_order_relaxed);
+      count = std::min(count, size());
+      if(items)
+        for(uInt32 i = 0; i < count; ++i)
+          items[i] = _buffer[(head + i) & (CAPACITY - 1)];
+      _head.store(head + count, std::memory_order_release);
+      return count;
+    }
+
+  private:
+    // Following constructors and assignment operators not supported
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue(LockFreeQueue&&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(LockFreeQueue&&) = delete;
+};
+
+}  // Namespace Common
+
+#endif
@@ -166,6 +166,74 @@ void PNGLibrary::saveImage(const string& filename, const FBSurface& surface,
   saveImage(out, rows, width, height, comments);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::saveImage(const string& filename, const uInt8* pixels,
+                           uInt32 width, uInt32 height, const uInt32* palette,
+                           uInt32 aspect, const VariantList& comments)
+{
+  #define savePalettedImageERROR(s) { err_message = s; goto done; }
+
+  ofstream out(filename, std::ios_base::binary);
+  if(!out.is_open())
+    throw runtime_error("ERROR: Couldn't create image file");
+
+  png_structp png_ptr = nullptr;
+  png_infop info_ptr = nullptr;
+  const char* err_message = nullptr;
+  png_color colors[256];
+  unique_ptr<png_bytep[]> rows = make_unique<png_bytep[]>(height);
+
+  // Create the PNG saving context structure
+  png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr,
+                 png_user_error, png_user_warn);
+  if(png_ptr == nullptr)
+    savePalettedImageERROR("Couldn't allocate memory for PNG file");
+
+  // Allocate/initialize the memory for image information.  REQUIRED.
+  info_ptr = png_create_info_struct(png_ptr);
+  if(info_ptr == nullptr)
+    savePalettedImageERROR("Couldn't create image information for PNG file");
+
+  // Set up the output control
+  png_set_write_fn(png_ptr, &out, png_write_data, png_io_flush);
+
+  // Write PNG header info; the palette indices are stored as they are
+  png_set_IHDR(png_ptr, info_ptr, width, height, 8,
+      PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+      PNG_FILTER_TYPE_DEFAULT);
+  for(int i = 0; i < 256; ++i)
+  {
+    colors[i].red   = (palette[i] >> 16) & 0xff;
+    colors[i].green = (palette[i] >> 8) & 0xff;
+    colors[i].blue  = palette[i] & 0xff;
+  }
+  png_set_PLTE(png_ptr, info_ptr, colors, 256);
+
+  // Pixels per unit, ie. the inverse of the pixel size
+  png_set_pHYs(png_ptr, info_ptr, 1, aspect, PNG_RESOLUTION_UNKNOWN);
+
+  // Write comments
+  writeComments(png_ptr, info_ptr, comments);
+
+  // Write the file header information.  REQUIRED
+  png_write_info(png_ptr, info_ptr);
+
+  // Write the entire image in one go
+  for(png_uint_32 k = 0; k < height; ++k)
+    rows[k] = png_bytep(pixels + k*width);
+  png_write_image(png_ptr, rows.get());
+
+  // We're finished writing
+  png_write_end(png_ptr, info_ptr);
+
+  // Cleanup
+done:
+  if(png_ptr)
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+  if(err_message)
+    throw runtime_error(err_message);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::saveImage(ofstream& out, const unique_ptr<png_bytep[]>& rows,
     png_uint_32 width, png_uint_32 height, const VariantList& comments)
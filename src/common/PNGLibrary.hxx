@@ -82,6 +82,28 @@ class PNGLibrary
                    const GUI::Rect& rect = GUI::EmptyRect,
                    const VariantList& comments = EmptyVarList);
 
+    /**
+      Save the given palette-indexed image (ie, a TIA frame) to a PNG file.
+      This doesn't depend on the framebuffer, and may be called from any
+      thread.
+
+      @param filename  The filename to save the PNG image
+      @param pixels    The palette index of each pixel
+      @param width     The width of the image
+      @param height    The height of the image
+      @param palette   The RGB values (0x00RRGGBB) of the 256 indices
+      @param aspect    The width of a pixel, relative to its height
+      @param comments  The text comments to add to the PNG image
+
+      @post  On success, the PNG file has been saved to 'filename',
+             otherwise a runtime_error is thrown containing a
+             more detailed error message.
+    */
+    static void saveImage(const string& filename, const uInt8* pixels,
+                          uInt32 width, uInt32 height, const uInt32* palette,
+                          uInt32 aspect = 1,
+                          const VariantList& comments = EmptyVarList);
+
   private:
     const FrameBuffer& myFB;
 
@@ -132,8 +154,8 @@ class PNGLibrary
     /**
       Write PNG tEXt chunks to the image.
     */
-    void writeComments(png_structp png_ptr, png_infop info_ptr,
-                       const VariantList& comments);
+    static void writeComments(png_structp png_ptr, png_infop info_ptr,
+                              const VariantList& comments);
 
     /** PNG library callback functions */
     static void png_read_data(png_structp ctx, png_bytep area, png_size_t size);
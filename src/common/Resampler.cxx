@@ -0,0 +1,128 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <cmath>
+
+#include "Resampler.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Resampler::Resampler()
+  : myHistoryPos(0),
+    myChannels(1),
+    myTime(0.0),
+    myStep(1.0),
+    myBaseStep(1.0)
+{
+  setRates(31400, 31400, 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Resampler::setRates(uInt32 inputRate, uInt32 outputRate, uInt32 channels)
+{
+  const double pi = 3.14159265358979323846;
+
+  myChannels = channels;
+  myBaseStep = myStep = double(inputRate) / outputRate;
+
+  // Cut off a little below the lower of the two Nyquist frequencies,
+  // relative to the input rate
+  double cutoff = 0.45 * std::min(1.0, double(outputRate) / inputRate);
+
+  for(uInt32 phase = 0; phase <= PHASES; ++phase)
+  {
+    float* filter = myFilter + phase * TAPS;
+    double sum = 0.0;
+    for(uInt32 tap = 0; tap < TAPS; ++tap)
+    {
+      // Distance from the output sample to this input sample, and its
+      // weight as a sinc, shaped by a Blackman window
+      double x = double(tap) - (TAPS / 2 - 1) - double(phase) / PHASES;
+      double sinc = x == 0.0 ? 1.0 : sin(2 * pi * cutoff * x) / (2 * pi * cutoff * x);
+      double w = pi * x / (TAPS / 2);
+      double window = 0.42 + 0.5 * cos(w) + 0.08 * cos(2 * w);
+      filter[tap] = float(sinc * window);
+      sum += filter[tap];
+    }
+
+    // Don't change the volume of each phase
+    for(uInt32 tap = 0; tap < TAPS; ++tap)
+      filter[tap] = float(filter[tap] / sum);
+  }
+
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Resampler::reset()
+{
+  memset(myHistory, 0, sizeof(myHistory));
+  myHistoryPos = 0;
+  myTime = 0.0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Resampler::inputFrames(uInt32 outputFrames) const
+{
+  // Step exactly like process() does, so rounding can't make them differ
+  double time = myTime;
+  uInt32 frames = 0;
+  for(uInt32 i = 0; i < outputFrames; ++i)
+  {
+    while(time >= 1.0)
+    {
+      time -= 1.0;
+      ++frames;
+    }
+    time += myStep;
+  }
+  return frames;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Resampler::process(const Int16* input, Int16* output, uInt32 outputFrames)
+{
+  for(uInt32 i = 0; i < outputFrames; ++i)
+  {
+    // Move the input samples which have been passed into the history
+    while(myTime >= 1.0)
+    {
+      for(uInt32 c = 0; c < myChannels; ++c)
+        myHistory[c][myHistoryPos] = myHistory[c][myHistoryPos + TAPS] = *input++;
+      myHistoryPos = (myHistoryPos + 1) % TAPS;
+      myTime -= 1.0;
+    }
+
+    // Interpolate between the two phases nearest to the output sample
+    double position = myTime * PHASES;
+    uInt32 phase = uInt32(position);
+    float fraction = float(position - phase);
+    const float* filter0 = myFilter + phase * TAPS;
+    const float* filter1 = filter0 + TAPS;
+
+    for(uInt32 c = 0; c < myChannels; ++c)
+    {
+      const Int16* history = myHistory[c] + myHistoryPos;
+      float sample = 0.0f;
+      for(uInt32 tap = 0; tap < TAPS; ++tap)
+        sample += history[tap] *
+                  (filter0[tap] + fraction * (filter1[tap] - filter0[tap]));
+
+      *output++ = Int16(BSPF::clamp(lrintf(sample), -32768L, 32767L));
+    }
+    myTime += myStep;
+  }
+}
@@ -0,0 +1,101 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef RESAMPLER_HXX
+#define RESAMPLER_HXX
+
+#include "bspf.hxx"
+
+/**
+  This class converts 16-bit sound from one sample rate to another, using
+  a polyphase windowed-sinc filter.  Besides filtering away the aliases of
+  the square waves generated by the TIA, the filter interpolates between
+  its phases, so the ratio between the rates can also be changed slightly
+  at any time (ie, to keep a queue of samples at a given size).
+*/
+class Resampler
+{
+  public:
+    Resampler();
+
+  public:
+    /**
+      Set the rates to convert between, and the number of channels
+      (1 or 2), and restart from silence.
+    */
+    void setRates(uInt32 inputRate, uInt32 outputRate, uInt32 channels);
+
+    /**
+      Restart from silence.
+    */
+    void reset();
+
+    /**
+      Change the speed at which the input is consumed, relative to the
+      ratio of the rates (ie, 1.001 consumes it 0.1% faster).
+    */
+    void adjustRate(double factor) { myStep = myBaseStep * factor; }
+
+    /**
+      Answers how many input frames the next call to process() will consume.
+
+      @param outputFrames  The number of frames which will be generated
+    */
+    uInt32 inputFrames(uInt32 outputFrames) const;
+
+    /**
+      Generate output frames from the given input frames; exactly
+      inputFrames(outputFrames) of them are consumed.
+
+      @param input         The input samples (interleaved, if stereo)
+      @param output        The output samples (interleaved, if stereo)
+      @param outputFrames  The number of frames to generate
+    */
+    void process(const Int16* input, Int16* output, uInt32 outputFrames);
+
+  private:
+    // The length of the filter, in input samples, and the number of
+    // phases (fractional positions between two input samples) it has
+    static constexpr uInt32 TAPS = 16;
+    static constexpr uInt32 PHASES = 64;
+
+    // The filter for each phase; one more is stored for interpolation
+    float myFilter[(PHASES + 1) * TAPS];
+
+    // The last input samples of each channel, stored twice, so that
+    // the last TAPS of them are always contiguous
+    Int16 myHistory[2][2 * TAPS];
+    uInt32 myHistoryPos;
+
+    uInt32 myChannels;
+
+    // The position of the next output sample, in input samples after the
+    // ones in the middle of the history, and the distance between two of
+    // them (with and without the rate adjustment)
+    double myTime;
+    double myStep;
+    double myBaseStep;
+
+  private:
+    // Following constructors and assignment operators not supported
+    Resampler(const Resampler&) = delete;
+    Resampler(Resampler&&) = delete;
+    Resampler& operator=(const Resampler&) = delete;
+    Resampler& operator=(Resampler&&) = delete;
+};
+
+#endif
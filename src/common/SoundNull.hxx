@@ -101,6 +101,13 @@ class SoundNull : public Sound
     */
     void set(uInt16 addr, uInt8 value, uInt64 cycle) override { }
 
+    /**
+      Generates the sound up to the given system cycle.
+
+      @param cycle  The current system cycle
+    */
+    void update(uInt64 cycle) override { }
+
     /**
       Sets the volume of the sound device to the specified level.  The
       volume is given as a percentage from 0 to 100.  Values outside
@@ -118,6 +125,14 @@ class SoundNull : public Sound
     */
     void adjustVolume(Int8 direction) override { }
 
+    /**
+      Gets the statistics of the sound device, since sound was opened.
+
+      @param stats The statistics
+      @return  False if sound isn't being played, so there are none
+    */
+    bool statistics(Statistics& stats) const override { return false; }
+
   public:
     /**
       Saves the current state of this device to the given Serializer.
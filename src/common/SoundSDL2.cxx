@@ -18,8 +18,6 @@
 #ifdef SOUND_SUPPORT
 
 #include <sstream>
-#include <cassert>
-#include <cmath>
 
 #include "SDL_lib.hxx"
 #include "TIASnd.hxx"
@@ -31,18 +29,53 @@
 #include "Console.hxx"
 #include "SoundSDL2.hxx"
 
+// The rate at which the TIA generates sound, and the CPU clock it's
+// derived from
+static constexpr Int32 TIA_RATE = 31400;
+static constexpr double CPU_CLOCK = 1193191.66666667;
+
+// How much faster or slower than the rate it's generated at the sound may
+// be played, to keep the sample queue at its target size
+static constexpr double MAX_RATE_ADJUST = 0.005;
+
+// In adaptive mode, the smallest fragment size used, and the number of
+// frames (5 msec) by which the margin of the queue grows or shrinks
+static constexpr uInt32 MIN_FRAGMENT_SIZE = 256;
+static constexpr uInt32 ADAPT_STEP = TIA_RATE / 200;
+
+// In adaptive mode, the number of checks (about a second each) without
+// underruns before latency is given back, at first and at most
+static constexpr uInt32 MIN_STABLE_CHECKS = 30;
+static constexpr uInt32 MAX_STABLE_CHECKS = 960;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL2::SoundSDL2(OSystem& osystem)
   : Sound(osystem),
     myIsEnabled(false),
     myIsInitializedFlag(false),
     myLastRegisterSetCycle(0),
+    mySampleFraction(0.0),
     myNumChannels(0),
-    myFragmentSizeLogBase2(0),
-    myFragmentSizeLogDiv1(0),
-    myFragmentSizeLogDiv2(0),
     myIsMuted(true),
-    myVolume(100)
+    myVolume(100),
+    myTargetQueueSize(0),
+    myRateAdjust(0.0),
+    myFrameRate(60.0),
+    myLastFrameCycle(0),
+    myClockRatio(1.0),
+    myIsPriming(true),
+    myUnderruns(0),
+    myOverruns(0),
+    myDroppedFrames(0),
+    myQueueSize(0),
+    myLatencyTarget(0),
+    myQueueMargin(0),
+    myAdaptFrames(0),
+    myAdaptUnderruns(0),
+    myStableChecks(0),
+    myStableLimit(MIN_STABLE_CHECKS),
+    myHasGivenBack(false),
+    myIsReopened(false)
 {
   myOSystem.logMessage("SoundSDL2::SoundSDL2 started ...", 2);
 
@@ -50,11 +83,55 @@ SoundSDL2::SoundSDL2(OSystem& osystem)
   // issues with opening and closing it multiple times
   // This fixes a bug most prevalent with ATI video cards in Windows,
   // whereby sound stopped working after the first video change
+  // (in adaptive mode, it's reopened when the fragment size changes)
+  uInt32 fragmentSize = myOSystem.settings().getInt("fragsize");
+
+  // In adaptive mode, start with fragments which take at most half the
+  // latency target
+  myLatencyTarget = myOSystem.settings().getInt("audiolatency");
+  if(myLatencyTarget > 0)
+  {
+    uInt32 freq = myOSystem.settings().getInt("freq");
+    while(fragmentSize > MIN_FRAGMENT_SIZE &&
+          fragmentSize * 2000 > myLatencyTarget * freq)
+      fragmentSize >>= 1;
+  }
+
+  if(!openDevice(fragmentSize))
+    return;
+
+  // Samples are generated by the emulation at the TIA's own rate, and
+  // converted to the device rate in the callback
+  myResampler.setRates(TIA_RATE, myHardwareSpec.freq, myHardwareSpec.channels);
+  mySampleQueue.clear(myHardwareSpec.channels);
+  myLastFrame[0] = myLastFrame[1] = 0;
+
+  myIsInitializedFlag = true;
+  updateTargetQueueSize();
+  SDL_PauseAudio(1);
+
+  myOSystem.logMessage("SoundSDL2::SoundSDL2 initialized", 2);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundSDL2::~SoundSDL2()
+{
+  // Close the SDL audio system if it's initialized
+  if(myIsInitializedFlag)
+  {
+    SDL_CloseAudio();
+    myIsEnabled = myIsInitializedFlag = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundSDL2::openDevice(uInt32 fragmentSize)
+{
   SDL_AudioSpec desired;
   desired.freq   = myOSystem.settings().getInt("freq");
   desired.format = AUDIO_S16SYS;
   desired.channels = 2;
-  desired.samples  = myOSystem.settings().getInt("fragsize");
+  desired.samples  = fragmentSize;
   desired.callback = callback;
   desired.userdata = static_cast<void*>(this);
 
@@ -64,7 +141,7 @@ SoundSDL2::SoundSDL2(OSystem& osystem)
     buf << "WARNING: Couldn't open SDL audio system! " << endl
         << "         " << SDL_GetError() << endl;
     myOSystem.logMessage(buf.str(), 0);
-    return;
+    return false;
   }
 
   // Make sure the sample buffer isn't to big (if it is the sound code
@@ -77,29 +154,54 @@ SoundSDL2::SoundSDL2(OSystem& osystem)
     myOSystem.logMessage(buf.str(), 0);
 
     SDL_CloseAudio();
-    return;
+    return false;
   }
 
-  // Pre-compute fragment-related variables as much as possible
-  myFragmentSizeLogBase2 = log(myHardwareSpec.samples) / log(2.0);
-  myFragmentSizeLogDiv1 = myFragmentSizeLogBase2 / 60.0;
-  myFragmentSizeLogDiv2 = (myFragmentSizeLogBase2 - 1) / 60.0;
-
-  myIsInitializedFlag = true;
-  SDL_PauseAudio(1);
+  myResampleBuffer.resize(2 * myHardwareSpec.channels *
+      (myHardwareSpec.samples * TIA_RATE / myHardwareSpec.freq + 16));
 
-  myOSystem.logMessage("SoundSDL2::SoundSDL2 initialized", 2);
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL2::~SoundSDL2()
+void SoundSDL2::setFragmentSize(uInt32 fragmentSize)
 {
-  // Close the SDL audio system if it's initialized
-  if(myIsInitializedFlag)
+  // This runs on the emulation thread, which is acceptable since it only
+  // happens when an adaptation check (about once a second) changes the
+  // fragment size, and reopening takes a few msec; the sound queued in the
+  // meantime plays once the device is open again
+  // The queue and the resampler are kept, since the callback won't run
+  // while the device is closed; only a different device format (which
+  // the reopened device shouldn't have) starts them over
+  uInt32 oldSize = myHardwareSpec.samples, oldFreq = myHardwareSpec.freq,
+         oldChannels = myHardwareSpec.channels;
+  SDL_PauseAudio(1);
+  SDL_CloseAudio();
+  if(!openDevice(fragmentSize) && !openDevice(oldSize))
   {
-    SDL_CloseAudio();
     myIsEnabled = myIsInitializedFlag = false;
+    return;
+  }
+  if(uInt32(myHardwareSpec.freq) != oldFreq ||
+     myHardwareSpec.channels != oldChannels)
+  {
+    myResampler.setRates(TIA_RATE, myHardwareSpec.freq, myHardwareSpec.channels);
+    mySampleQueue.clear(myHardwareSpec.channels);
+    myLastFrame[0] = myLastFrame[1] = 0;
   }
+  updateTargetQueueSize();
+
+  // Let the queue fill up to the new target before playing, and don't
+  // hold the underruns which starting the device may cause against it
+  myIsPriming = true;
+  myIsReopened = true;
+
+  ostringstream buf;
+  buf << "Sound fragment size changed from " << oldSize << " to "
+      << uInt32(myHardwareSpec.samples);
+  myOSystem.logMessage(buf.str(), 2);
+
+  SDL_PauseAudio(myIsMuted ? 1 : 0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -124,7 +226,7 @@ void SoundSDL2::open()
   }
 
   // Now initialize the TIASound object which will actually generate sound
-  myTIASound.outputFrequency(myHardwareSpec.freq);
+  myTIASound.outputFrequency(TIA_RATE);
   const string& chanResult =
       myTIASound.channels(myHardwareSpec.channels, myNumChannels == 2);
 
@@ -132,6 +234,12 @@ void SoundSDL2::open()
   myVolume = myOSystem.settings().getInt("volume");
   setVolume(myVolume);
 
+  // Statistics are kept for each time sound is opened
+  myUnderruns = myOverruns = myDroppedFrames = myQueueSize = 0;
+  myAdaptFrames = myAdaptUnderruns = myStableChecks = 0;
+  myStableLimit = MIN_STABLE_CHECKS;
+  myHasGivenBack = false;
+
   // Show some info
   ostringstream buf;
   buf << "Sound enabled:"  << endl
@@ -140,7 +248,12 @@ void SoundSDL2::open()
       << "  Frequency:   " << uInt32(myHardwareSpec.freq) << endl
       << "  Channels:    " << uInt32(myHardwareSpec.channels)
                            << " (" << chanResult << ")" << endl
-      << endl;
+      << "  Latency:     ";
+  if(myLatencyTarget > 0)
+    buf << "adaptive, " << myLatencyTarget << " msec" << endl;
+  else
+    buf << "fixed" << endl;
+  buf << endl;
   myOSystem.logMessage(buf.str(), 1);
 
   // And start the SDL sound subsystem ...
@@ -155,11 +268,28 @@ void SoundSDL2::close()
 {
   if(myIsInitializedFlag)
   {
+    Statistics stats;
+    if(statistics(stats))
+    {
+      ostringstream buf;
+      buf << "Sound statistics:" << endl
+          << "  Frag size:   " << stats.fragmentSize << endl
+          << "  Latency:     " << stats.latency << " msec (target "
+                               << stats.targetLatency << " msec)" << endl
+          << "  Underruns:   " << stats.underruns << endl
+          << "  Overruns:    " << stats.overruns << endl
+          << "  Dropped:     " << stats.droppedSamples << " samples" << endl
+          << endl;
+      myOSystem.logMessage(buf.str(), 1);
+    }
+
     myIsEnabled = false;
     SDL_PauseAudio(1);
     myLastRegisterSetCycle = 0;
+    mySampleFraction = 0.0;
     myTIASound.reset();
-    myRegWriteQueue.clear();
+    mySampleQueue.clear(myHardwareSpec.channels);
+    myResampler.reset();
     myOSystem.logMessage("SoundSDL2::close", 2);
   }
 }
@@ -170,6 +300,11 @@ void SoundSDL2::mute(bool state)
   if(myIsInitializedFlag)
   {
     myIsMuted = state;
+
+    // The queue is empty after being muted, so it should fill up before
+    // anything is played (or counted as an underrun)
+    if(!myIsMuted)
+      myIsPriming = true;
     SDL_PauseAudio(myIsMuted ? 1 : 0);
   }
 }
@@ -181,8 +316,10 @@ void SoundSDL2::reset()
   {
     SDL_PauseAudio(1);
     myLastRegisterSetCycle = 0;
+    mySampleFraction = 0.0;
     myTIASound.reset();
-    myRegWriteQueue.clear();
+    mySampleQueue.clear(myHardwareSpec.channels);
+    myResampler.reset();
     mute(myIsMuted);
   }
 }
@@ -193,10 +330,8 @@ void SoundSDL2::setVolume(Int32 percent)
   if(myIsInitializedFlag && (percent >= 0) && (percent <= 100))
   {
     myOSystem.settings().setValue("volume", percent);
-    SDL_LockAudio();
     myVolume = percent;
     myTIASound.volume(percent);
-    SDL_UnlockAudio();
   }
 }
 
@@ -236,31 +371,156 @@ void SoundSDL2::setChannels(uInt32 channels)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::setFrameRate(float framerate)
 {
-  // Recalculate since frame rate has changed
-  // FIXME - should we clear out the queue or adjust the values in it?
-  myFragmentSizeLogDiv1 = myFragmentSizeLogBase2 / framerate;
-  myFragmentSizeLogDiv2 = (myFragmentSizeLogBase2 - 1) / framerate;
+  myFrameRate = framerate;
+  if(myIsInitializedFlag)
+    updateTargetQueueSize();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::updateTargetQueueSize()
+{
+  // The emulation adds a frame of sound at a time, and the callback takes
+  // a fragment at a time; the queue should hold both
+  myTargetQueueSize = uInt32(TIA_RATE / myFrameRate) +
+      myHardwareSpec.samples * TIA_RATE / myHardwareSpec.freq + myQueueMargin;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 SoundSDL2::latency(uInt32 queueSize, uInt32 fragmentSize) const
+{
+  return queueSize * 1000 / TIA_RATE + fragmentSize * 1000 / myHardwareSpec.freq;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::set(uInt16 addr, uInt8 value, uInt64 cycle)
 {
-  SDL_LockAudio();
+  // The sound up to this point still uses the previous value
+  generate(cycle);
+  myTIASound.set(addr, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::update(uInt64 cycle)
+{
+  generate(cycle);
 
-  // First, calculate how many seconds would have past since the last
-  // register write on a real 2600
-  double delta = double(cycle - myLastRegisterSetCycle) / 1193191.66666667;
+  // This is called at the end of each frame, so the cycles since the last
+  // call give the length of the frame (jumps in time are ignored)
+  if(cycle > myLastFrameCycle)
+  {
+    const double ratio = (cycle - myLastFrameCycle) * myFrameRate / CPU_CLOCK;
+    if(ratio > 0.5 && ratio < 2.0)
+      myClockRatio = myClockRatio + (ratio - myClockRatio) / 16;
+  }
+  myLastFrameCycle = cycle;
+
+  if(myLatencyTarget > 0 && myIsEnabled && !myIsMuted &&
+     ++myAdaptFrames >= myFrameRate)
+  {
+    myAdaptFrames = 0;
+    adapt();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::adapt()
+{
+  uInt32 underruns = myUnderruns - myAdaptUnderruns;
+  myAdaptUnderruns += underruns;
+  uInt32 fragmentSize = myHardwareSpec.samples;
 
-  // Now, adjust the time based on the frame rate the user has selected. For
-  // the sound to "scale" correctly, we have to know the games real frame
-  // rate (e.g., 50 or 60) and the currently emulated frame rate. We use these
-  // values to "scale" the time before the register change occurs.
-  myRegWriteQueue.enqueue(addr, value, delta);
+  // The first check after reopening the device only starts counting
+  if(myIsReopened)
+  {
+    myIsReopened = false;
+    return;
+  }
 
-  // Update last cycle counter to the current cycle
+  if(underruns > 0)
+  {
+    // More sound should be waiting; if that would exceed the latency
+    // target, make room with smaller fragments instead
+    // When giving back latency caused this, wait twice as long before
+    // trying that again
+    if(myHasGivenBack)
+      myStableLimit = std::min(myStableLimit << 1, MAX_STABLE_CHECKS);
+    myHasGivenBack = false;
+    myStableChecks = 0;
+    if(latency(myTargetQueueSize + ADAPT_STEP, fragmentSize) <= myLatencyTarget)
+      myQueueMargin += ADAPT_STEP;
+    else if(fragmentSize > MIN_FRAGMENT_SIZE)
+      setFragmentSize(fragmentSize >> 1);
+  }
+  else if(++myStableChecks >= myStableLimit)
+  {
+    // After a while without underruns, give back some latency, and then
+    // go back to larger fragments (which are played more efficiently)
+    myStableChecks = 0;
+    myHasGivenBack = false;
+    if(myQueueMargin > 0)
+    {
+      myQueueMargin -= std::min(myQueueMargin, ADAPT_STEP);
+      myHasGivenBack = true;
+    }
+    else if(fragmentSize < uInt32(myOSystem.settings().getInt("fragsize")) &&
+            latency(myTargetQueueSize + fragmentSize * TIA_RATE /
+                    myHardwareSpec.freq, fragmentSize << 1) <= myLatencyTarget)
+    {
+      setFragmentSize(fragmentSize << 1);
+      myHasGivenBack = true;
+    }
+  }
+  updateTargetQueueSize();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::generate(uInt64 cycle)
+{
+  // A state may have been loaded, or the debugger may have stopped the
+  // emulation for a while; such jumps in time are simply skipped
+  if(cycle <= myLastRegisterSetCycle ||
+     cycle - myLastRegisterSetCycle > CPU_CLOCK || !myIsEnabled || myIsMuted)
+  {
+    myLastRegisterSetCycle = cycle;
+    return;
+  }
+
+  double samples = (cycle - myLastRegisterSetCycle) * (TIA_RATE / CPU_CLOCK) +
+                   mySampleFraction;
+  uInt32 frames = uInt32(samples);
+  mySampleFraction = samples - frames;
   myLastRegisterSetCycle = cycle;
 
-  SDL_UnlockAudio();
+  const uInt32 bufferFrames = 512;
+  while(frames > 0)
+  {
+    uInt32 count = std::min(frames, bufferFrames);
+    myTIASound.process(myGenerateBuffer, count);
+    uInt32 dropped = count - mySampleQueue.write(myGenerateBuffer, count);
+    if(dropped > 0)
+    {
+      ++myOverruns;
+      myDroppedFrames += dropped;
+    }
+    frames -= count;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundSDL2::statistics(Statistics& stats) const
+{
+  if(!myIsInitializedFlag || !myIsEnabled)
+    return false;
+
+  uInt32 fragmentSize = myHardwareSpec.samples;
+  stats.fragmentSize   = fragmentSize;
+  stats.latency        = latency(myQueueSize, fragmentSize);
+  stats.targetLatency  = latency(myTargetQueueSize, fragmentSize);
+  stats.underruns      = myUnderruns;
+  stats.overruns       = myOverruns;
+  stats.droppedSamples = myDroppedFrames;
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -269,79 +529,57 @@ void SoundSDL2::processFragment(Int16* stream, uInt32 length)
   uInt32 channels = myHardwareSpec.channels;
   length = length / channels;
 
-  // If there are excessive items on the queue then we'll remove some
-  if(myRegWriteQueue.duration() > myFragmentSizeLogDiv1)
+  uInt32 queued = mySampleQueue.size(), target = myTargetQueueSize;
+  myQueueSize = queued;
+
+  // Until the queue has filled up, the last frame is held
+  if(myIsPriming)
   {
-    double removed = 0.0;
-    while(removed < myFragmentSizeLogDiv2)
+    if(queued < target)
     {
-      RegWrite& info = myRegWriteQueue.front();
-      removed += info.delta;
-      myTIASound.set(info.addr, info.value);
-      myRegWriteQueue.dequeue();
+      for(uInt32 i = 0; i < length * channels; ++i)
+        stream[i] = myLastFrame[i % channels];
+      return;
     }
+    myIsPriming = false;
   }
 
-  double position = 0.0;
-  double remaining = length;
+  // If there are excessive samples in the queue (ie, after fast-forward),
+  // skip them, so the sound doesn't lag behind
+  if(queued > 4 * target)
+  {
+    ++myOverruns;
+    myDroppedFrames += mySampleQueue.read(nullptr, queued - target);
+    queued = target;
+  }
 
-  while(remaining > 0.0)
+  // Otherwise play slightly faster or slower, to get the queue back to its
+  // target size (and so track the emulation) without audible artifacts
+  double error = (double(queued) - target) / target;
+  myRateAdjust += (BSPF::clamp(error, -1.0, 1.0) * MAX_RATE_ADJUST -
+                   myRateAdjust) / 16;
+  myResampler.adjustRate(myClockRatio * (1.0 + myRateAdjust));
+
+  uInt32 needed = myResampler.inputFrames(length);
+  if(myResampleBuffer.size() < needed * channels)
+    myResampleBuffer.resize(needed * channels);
+  Int16* input = myResampleBuffer.data();
+
+  // When the queue runs dry, the last frame is held until it has filled
+  // up again, so a late frame causes a single gap rather than several
+  uInt32 frames = mySampleQueue.read(input, needed);
+  if(frames > 0)
+    for(uInt32 c = 0; c < channels; ++c)
+      myLastFrame[c] = input[(frames - 1) * channels + c];
+  if(frames < needed)
   {
-    if(myRegWriteQueue.size() == 0)
-    {
-      // There are no more pending TIA sound register updates so we'll
-      // use the current settings to finish filling the sound fragment
-      myTIASound.process(stream + (uInt32(position) * channels),
-          length - uInt32(position));
-
-      // Since we had to fill the fragment we'll reset the cycle counter
-      // to zero.  NOTE: This isn't 100% correct, however, it'll do for
-      // now.  We should really remember the overrun and remove it from
-      // the delta of the next write.
-      myLastRegisterSetCycle = 0;
-      break;
-    }
-    else
-    {
-      // There are pending TIA sound register updates so we need to
-      // update the sound buffer to the point of the next register update
-      RegWrite& info = myRegWriteQueue.front();
-
-      // How long will the remaining samples in the fragment take to play
-      double duration = remaining / myHardwareSpec.freq;
-
-      // Does the register update occur before the end of the fragment?
-      if(info.delta <= duration)
-      {
-        // If the register update time hasn't already passed then
-        // process samples upto the point where it should occur
-        if(info.delta > 0.0)
-        {
-          // Process the fragment upto the next TIA register write.  We
-          // round the count passed to process up if needed.
-          double samples = (myHardwareSpec.freq * info.delta);
-          myTIASound.process(stream + (uInt32(position) * channels),
-              uInt32(samples) + uInt32(position + samples) -
-              (uInt32(position) + uInt32(samples)));
-
-          position += samples;
-          remaining -= samples;
-        }
-        myTIASound.set(info.addr, info.value);
-        myRegWriteQueue.dequeue();
-      }
-      else
-      {
-        // The next register update occurs in the next fragment so finish
-        // this fragment with the current TIA settings and reduce the register
-        // update delay by the corresponding amount of time
-        myTIASound.process(stream + (uInt32(position) * channels),
-            length - uInt32(position));
-        info.delta -= duration;
-        break;
-      }
-    }
+    ++myUnderruns;
+    myIsPriming = true;
+    for(uInt32 i = frames * channels; i < needed * channels; ++i)
+      input[i] = myLastFrame[i % channels];
   }
+
+  myResampler.process(input, stream, length);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -404,20 +642,24 @@ bool SoundSDL2::load(Serializer& in)
     if(myIsInitializedFlag)
     {
       SDL_PauseAudio(1);
-      myRegWriteQueue.clear();
+      mySampleQueue.clear(myHardwareSpec.channels);
       myTIASound.set(TIARegister::AUDC0, in.getByte());
       myTIASound.set(TIARegister::AUDC1, in.getByte());
       myTIASound.set(TIARegister::AUDF0, in.getByte());
       myTIASound.set(TIARegister::AUDF1, in.getByte());
       myTIASound.set(TIARegister::AUDV0, in.getByte());
       myTIASound.set(TIARegister::AUDV1, in.getByte());
+      myLastRegisterSetCycle = in.getLong();
+      mySampleFraction = 0.0;
+      myIsPriming = true;
       if(!myIsMuted) SDL_PauseAudio(0);
     }
     else
+    {
       for(int i = 0; i < 6; ++i)
         in.getByte();
-
-    myLastRegisterSetCycle = in.getLong();
+      myLastRegisterSetCycle = in.getLong();
+    }
   }
   catch(...)
   {
@@ -429,83 +671,36 @@ bool SoundSDL2::load(Serializer& in)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL2::RegWriteQueue::RegWriteQueue(uInt32 capacity)
-  : myBuffer(make_unique<RegWrite[]>(capacity)),
-    myCapacity(capacity),
-    mySize(0),
-    myHead(0),
-    myTail(0)
+SoundSDL2::SampleQueue::SampleQueue()
+  : myChannels(2)
 {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::clear()
+void SoundSDL2::SampleQueue::clear(uInt32 channels)
 {
-  myHead = myTail = mySize = 0;
+  myChannels = channels;
+  mySamples.clear();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::dequeue()
+uInt32 SoundSDL2::SampleQueue::write(const Int16* samples, uInt32 frames)
 {
-  if(mySize > 0)
-  {
-    myHead = (myHead + 1) % myCapacity;
-    --mySize;
-  }
+  frames = std::min(frames, mySamples.space() / myChannels);
+  return mySamples.write(samples, frames * myChannels) / myChannels;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-double SoundSDL2::RegWriteQueue::duration() const
+uInt32 SoundSDL2::SampleQueue::read(Int16* samples, uInt32 frames)
 {
-  double duration = 0.0;
-  for(uInt32 i = 0; i < mySize; ++i)
-  {
-    duration += myBuffer[(myHead + i) % myCapacity].delta;
-  }
-  return duration;
+  frames = std::min(frames, size());
+  return mySamples.read(samples, frames * myChannels) / myChannels;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::enqueue(uInt16 addr, uInt8 value, double delta)
+uInt32 SoundSDL2::SampleQueue::size() const
 {
-  // If an attempt is made to enqueue more than the queue can hold then
-  // we'll enlarge the queue's capacity.
-  if(mySize == myCapacity)
-    grow();
-
-  RegWrite& reg = myBuffer[myTail];
-  reg.addr  = addr;
-  reg.value = value;
-  reg.delta = delta;
-  myTail = (myTail + 1) % myCapacity;
-  ++mySize;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL2::RegWrite& SoundSDL2::RegWriteQueue::front() const
-{
-  assert(mySize != 0);
-  return myBuffer[myHead];
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 SoundSDL2::RegWriteQueue::size() const
-{
-  return mySize;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::grow()
-{
-  unique_ptr<RegWrite[]> buffer = make_unique<RegWrite[]>(myCapacity*2);
-  for(uInt32 i = 0; i < mySize; ++i)
-    buffer[i] = myBuffer[(myHead + i) % myCapacity];
-
-  myHead = 0;
-  myTail = mySize;
-  myCapacity *= 2;
-
-  myBuffer = std::move(buffer);
+  return mySamples.size() / myChannels;
 }
 
 #endif  // SOUND_SUPPORT
@@ -22,10 +22,14 @@
 
 class OSystem;
 
+#include <atomic>
+
 #include "SDL_lib.hxx"
 
 #include "bspf.hxx"
 #include "TIASnd.hxx"
+#include "Resampler.hxx"
+#include "LockFreeQueue.hxx"
 #include "Sound.hxx"
 
 /**
@@ -67,8 +71,8 @@ class SoundSDL2 : public Sound
     void setChannels(uInt32 channels) override;
 
     /**
-      Sets the display framerate.  Sound generation for NTSC and PAL games
-      depends on the framerate, so we need to set it here.
+      Sets the display framerate.  The emulation generates sound a frame
+      at a time, so the sample queue is sized accordingly.
 
       @param framerate The base framerate depending on NTSC or PAL ROM
     */
@@ -107,6 +111,13 @@ class SoundSDL2 : public Sound
     */
     void set(uInt16 addr, uInt8 value, uInt64 cycle) override;
 
+    /**
+      Generates the sound up to the given system cycle.
+
+      @param cycle  The current system cycle
+    */
+    void update(uInt64 cycle) override;
+
     /**
       Sets the volume of the sound device to the specified level.  The
       volume is given as a percentage from 0 to 100.  Values outside
@@ -124,6 +135,14 @@ class SoundSDL2 : public Sound
     */
     void adjustVolume(Int8 direction) override;
 
+    /**
+      Gets the statistics of the sound device, since sound was opened.
+
+      @param stats  The statistics
+      @return  False if sound isn't being played, so there are none
+    */
+    bool statistics(Statistics& stats) const override;
+
   public:
     /**
       Saves the current state of this device to the given Serializer.
@@ -159,88 +178,103 @@ class SoundSDL2 : public Sound
     */
     void processFragment(Int16* stream, uInt32 length);
 
-  protected:
-    // Struct to hold information regarding a TIA sound register write
-    struct RegWrite
-    {
-      uInt16 addr;
-      uInt8 value;
-      double delta;
+    /**
+      Generate the sound samples up to the given system cycle, and queue
+      them for the sound callback.
+    */
+    void generate(uInt64 cycle);
 
-      RegWrite(uInt16 a = 0, uInt8 v = 0, double d = 0.0)
-        : addr(a), value(v), delta(d) { }
-    };
+    /**
+      Open the SDL audio device with the given fragment size.
+
+      @return  Whether the device could be opened
+    */
+    bool openDevice(uInt32 fragmentSize);
+
+    /**
+      Reopen the SDL audio device with a different fragment size, keeping
+      the sound which is already queued.
+    */
+    void setFragmentSize(uInt32 fragmentSize);
+
+    /**
+      Update the number of frames the queue should hold, from the
+      framerate, the fragment size and the current margin.
+    */
+    void updateTargetQueueSize();
+
+    /**
+      Answers the latency (in msec) when the queue holds the given number
+      of frames, and fragments of the given size are played.
+    */
+    uInt32 latency(uInt32 queueSize, uInt32 fragmentSize) const;
 
     /**
-      A queue class used to hold TIA sound register writes before being
-      processed while creating a sound fragment.
+      Called about once a second in adaptive mode; grows the margin of the
+      queue (or shrinks the fragments, when the latency target leaves no
+      room) when there were underruns, and slowly gives back latency while
+      there are none.
     */
-    class RegWriteQueue
+    void adapt();
+
+  protected:
+    /**
+      A fixed-size queue which passes the generated sound samples from the
+      emulation (the only producer) to the sound callback (the only
+      consumer).  It is lock-free, so neither side ever waits for the other.
+      Samples are counted in frames, ie. one sample for each channel, so
+      that a frame is never split.
+    */
+    class SampleQueue
     {
       public:
-        /**
-          Create a new queue instance with the specified initial
-          capacity.  If the queue ever reaches its capacity then it will
-          automatically increase its size.
-        */
-        RegWriteQueue(uInt32 capacity = 512);
+        SampleQueue();
 
       public:
         /**
-          Clear any items stored in the queue.
+          Clear any samples stored in the queue, and set the number of
+          channels.  This may only be called while the sound callback
+          isn't running.
         */
-        void clear();
+        void clear(uInt32 channels);
 
         /**
-          Dequeue the first object in the queue.
-        */
-        void dequeue();
+          Add the given frames to the queue (producer only).
 
-        /**
-          Return the duration of all the items in the queue.
-        */
-        double duration() const;
-
-        /**
-          Enqueue the specified object.
+          @return  The number of frames added, which is less than requested
+                   if the queue is full
         */
-        void enqueue(uInt16 addr, uInt8 value, double delta);
+        uInt32 write(const Int16* samples, uInt32 frames);
 
         /**
-          Return the item at the front on the queue.
+          Remove frames from the queue (consumer only).
 
-          @return  The item at the front of the queue.
+          @param samples  Where to store the frames, or nullptr to drop them
+          @return  The number of frames removed, which is less than
+                   requested if the queue doesn't contain enough
         */
-        RegWrite& front() const;
+        uInt32 read(Int16* samples, uInt32 frames);
 
         /**
-          Answers the number of items currently in the queue.
-
-          @return  The number of items in the queue.
+          Answers the number of frames currently in the queue.
         */
         uInt32 size() const;
 
       private:
-        // Increase the size of the queue
-        void grow();
-
-      private:
-        unique_ptr<RegWrite[]> myBuffer;
-        uInt32 myCapacity;
-        uInt32 mySize;
-        uInt32 myHead;
-        uInt32 myTail;
+        Common::LockFreeQueue<Int16, 16384> mySamples;
+        uInt32 myChannels;
 
       private:
         // Following constructors and assignment operators not supported
-        RegWriteQueue(const RegWriteQueue&) = delete;
-        RegWriteQueue(RegWriteQueue&&) = delete;
-        RegWriteQueue& operator=(const RegWriteQueue&) = delete;
-        RegWriteQueue& operator=(RegWriteQueue&&) = delete;
+        SampleQueue(const SampleQueue&) = delete;
+        SampleQueue(SampleQueue&&) = delete;
+        SampleQueue& operator=(const SampleQueue&) = delete;
+        SampleQueue& operator=(SampleQueue&&) = delete;
     };
 
   private:
-    // TIASound emulation object
+    // TIASound emulation object; it generates the sound at its native
+    // rate, in step with the emulation
     TIASound myTIASound;
 
     // Indicates if the sound subsystem is to be initialized
@@ -249,21 +283,14 @@ class SoundSDL2 : public Sound
     // Indicates if the sound device was successfully initialized
     bool myIsInitializedFlag;
 
-    // Indicates the cycle when a sound register was last set
+    // Indicates the cycle up to which sound has been generated, and the
+    // fraction of a sample left over at that point
     uInt64 myLastRegisterSetCycle;
+    double mySampleFraction;
 
     // Indicates the number of channels (mono or stereo)
     uInt32 myNumChannels;
 
-    // Log base 2 of the selected fragment size
-    double myFragmentSizeLogBase2;
-
-    // The myFragmentSizeLogBase2 variable is used in only two places,
-    // both of which involve an expensive division in the sound
-    // processing callback
-    // These are pre-computed to speed up the callback as much as possible
-    double myFragmentSizeLogDiv1, myFragmentSizeLogDiv2;
-
     // Indicates if the sound is currently muted
     bool myIsMuted;
 
@@ -273,8 +300,60 @@ class SoundSDL2 : public Sound
     // Audio specification structure
     SDL_AudioSpec myHardwareSpec;
 
-    // Queue of TIA register writes
-    RegWriteQueue myRegWriteQueue;
+    // Samples generated by the emulation, and waiting to be played
+    SampleQueue mySampleQueue;
+
+    // Buffer used by the emulation while generating samples
+    Int16 myGenerateBuffer[2 * 512];
+
+    // Converts the samples to the rate of the sound device, and the
+    // buffer used by the sound callback for its input
+    Resampler myResampler;
+    vector<Int16> myResampleBuffer;
+
+    // The number of frames the queue should hold when the callback runs,
+    // and how much faster (or slower) than normal they are currently played
+    // to get there
+    std::atomic<uInt32> myTargetQueueSize;
+    double myRateAdjust;
+    float myFrameRate;
+
+    // The emulation runs a frame of (scanlines * 76) cycles per 1/framerate
+    // second, rather than at the CPU clock of a real console; the cycle at
+    // which the last frame ended, and how much faster than the TIA rate
+    // the sound is generated because of this
+    uInt64 myLastFrameCycle;
+    std::atomic<double> myClockRatio;
+
+    // The last frame played, repeated when the queue runs dry, and whether
+    // the callback waits for the queue to fill up before playing it
+    Int16 myLastFrame[2];
+    std::atomic<bool> myIsPriming;
+
+    // Number of times the queue ran dry or overflowed, number of frames
+    // which had to be thrown away, and the size of the queue when the
+    // callback last ran
+    std::atomic<uInt32> myUnderruns;
+    std::atomic<uInt32> myOverruns;
+    std::atomic<uInt32> myDroppedFrames;
+    std::atomic<uInt32> myQueueSize;
+
+    // The latency (in msec) to stay within in adaptive mode (0 when the
+    // fragment size is fixed), the extra frames the queue holds to avoid
+    // underruns, and what has happened since the last adaptation
+    uInt32 myLatencyTarget;
+    uInt32 myQueueMargin;
+    uInt32 myAdaptFrames;
+    uInt32 myAdaptUnderruns;
+
+    // Number of checks without underruns so far, and how many there must
+    // be before latency is given back; and whether that was just done
+    uInt32 myStableChecks;
+    uInt32 myStableLimit;
+    bool myHasGivenBack;
+
+    // Whether the device was reopened since the last adaptation check
+    bool myIsReopened;
 
   private:
     // Callback function invoked by the SDL Audio library when it needs data
@@ -22,19 +22,24 @@
 #include "Control.hxx"
 #include "Switches.hxx"
 #include "System.hxx"
+#include "TIA.hxx"
 #include "Serializable.hxx"
 #include "RewindManager.hxx"
 
 #include "StateManager.hxx"
 
-#define STATE_HEADER "05000304state"
+#define STATE_HEADER "05000306state"
 // #define MOVIE_HEADER "03030000movie"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 StateManager::StateManager(OSystem& osystem)
   : myOSystem(osystem),
     myCurrentSlot(0),
-    myActiveMode(Mode::Off)
+    myActiveMode(Mode::Off),
+    myRunAheadFrames(0),
+    myRunAheadCount(0),
+    myRunAheadTime(0),
+    myRunAheadCost(0.0f)
 {
   myRewindManager = make_unique<RewindManager>(myOSystem, *this);
   reset();
@@ -354,6 +359,43 @@ bool StateManager::saveState(Serializer& out)
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StateManager::runAhead(uInt32 frames)
+{
+  TIA& tia = myOSystem.console().tia();
+
+  // The in-memory state is reused, so saving and loading it doesn't have
+  // to allocate anything
+  tia.setRunAhead(true);
+  myRunAheadState.rewind();
+  bool restored = false;
+  if(saveState(myRunAheadState))
+  {
+    tia.setLogicOnly(true);
+    for(uInt32 i = 1; i < frames; ++i)
+      tia.update();
+    tia.setLogicOnly(false);
+    tia.update();
+
+    myRunAheadState.rewind();
+    restored = loadState(myRunAheadState);
+  }
+  tia.setRunAhead(false);
+
+  // Update the cost (frames emulated ahead per second) about once a second
+  myRunAheadCount += frames;
+  const uInt64 now = myOSystem.getTicks();
+  if(now < myRunAheadTime || now - myRunAheadTime >= 1000000)
+  {
+    if(now > myRunAheadTime && myRunAheadTime > 0)
+      myRunAheadCost = myRunAheadCount * 1000000.0f / (now - myRunAheadTime);
+    myRunAheadCount = 0;
+    myRunAheadTime = now;
+  }
+
+  return restored;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void StateManager::reset()
 {
@@ -361,6 +403,30 @@ void StateManager::reset()
   myActiveMode = myOSystem.settings().getBool(
     myOSystem.settings().getBool("dev.settings") ? "dev.rewind" : "plr.rewind") ? Mode::Rewind : Mode::Off;
 
+  myRunAheadFrames = myOSystem.settings().getInt("runahead");
+
+  // Controllers which talk to the outside world (the SaveKey/AtariVox
+  // EEPROM file, AtariVox speech, KidVid tapes) would do so for frames
+  // which are undone, and their state isn't restored with the frame
+  if(myRunAheadFrames > 0 && myOSystem.hasConsole())
+  {
+    for(Controller* c: { &myOSystem.console().leftController(),
+                         &myOSystem.console().rightController() })
+    {
+      if(c->type() == Controller::SaveKey || c->type() == Controller::AtariVox ||
+         c->type() == Controller::KidVid)
+      {
+        myRunAheadFrames = 0;
+        myOSystem.logMessage("Run-ahead disabled for " + c->name() +
+                             " controller", 1);
+        break;
+      }
+    }
+  }
+  myRunAheadCount = 0;
+  myRunAheadTime = 0;
+  myRunAheadCost = 0.0f;
+
 #if 0
   myCurrentSlot = 0;
 
@@ -125,6 +125,24 @@ class StateManager
     */
     bool saveState(Serializer& out);
 
+    /**
+      Emulate the given number of frames ahead of the current state, with
+      only the last one rendered, and then return to the current state.
+      This way, the frame buffer shows the result of the current input
+      that many frames early, hiding the input lag of the ROM.
+
+      @param frames  The number of frames to run ahead
+      @return  Whether the current state was restored
+    */
+    bool runAhead(uInt32 frames);
+
+    /**
+      Answers the number of frames to run ahead of each displayed frame
+      (0 if disabled), and how many frames per second this costs.
+    */
+    uInt32 runAheadFrames() const { return myRunAheadFrames; }
+    float runAheadCost() const { return myRunAheadCost; }
+
     /**
       Resets manager to defaults.
     */
@@ -159,6 +177,14 @@ class StateManager
     // Stored savestates to be later rewound
     unique_ptr<RewindManager> myRewindManager;
 
+    // Number of frames to run ahead, the in-memory state to return to,
+    // and the frames emulated ahead since the last cost update
+    uInt32 myRunAheadFrames;
+    Serializer myRunAheadState;
+    uInt32 myRunAheadCount;
+    uInt64 myRunAheadTime;
+    float myRunAheadCost;
+
   private:
     // Following constructors and assignment operators not supported
     StateManager() = delete;
@@ -6,10 +6,12 @@ MODULE_OBJS := \
 	src/common/EventHandlerSDL2.o \
 	src/common/FrameBufferSDL2.o \
 	src/common/FBSurfaceSDL2.o \
+	src/common/CaptureManager.o \
 	src/common/SoundSDL2.o \
 	src/common/FSNodeZIP.o \
 	src/common/PNGLibrary.o \
 	src/common/MouseControl.o \
+	src/common/Resampler.o \
 	src/common/RewindManager.o \
 	src/common/StateManager.o \
 	src/common/ZipHandler.o
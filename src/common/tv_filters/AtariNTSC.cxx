@@ -18,6 +18,27 @@
 #include <thread>
 #include "AtariNTSC.hxx"
 
+#if defined(__linux__)
+  #include <pthread.h>
+#elif defined(BSPF_WINDOWS)
+  #define NOMINMAX
+  #include <windows.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define ATARI_NTSC_X86
+  #include <immintrin.h>
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+    #define ATARI_NTSC_TARGET(arch)
+  #else
+    #define ATARI_NTSC_TARGET(arch) __attribute__((target(arch)))
+  #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define ATARI_NTSC_NEON
+  #include <arm_neon.h>
+#endif
+
 // blitter related
 #ifndef restrict
   #if defined (__GNUC__)
@@ -67,9 +88,16 @@ void AtariNTSC::initializePalette(const uInt8* palette)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::enableThreading(bool enable)
+void AtariNTSC::enableThreading(bool enable, uInt32 numThreads, bool affinity)
 {
-  uInt32 systemThreads = enable ? std::thread::hardware_concurrency() : 0;
+  stopThreads();
+
+  uInt32 systemThreads = std::thread::hardware_concurrency();
+  if(!enable)
+    systemThreads = 0;
+  else if(numThreads > 0)
+    systemThreads = numThreads;
+
   if(systemThreads <= 1)
   {
     myWorkerThreads = 0;
@@ -77,12 +105,105 @@ void AtariNTSC::enableThreading(bool enable)
   }
   else
   {
-    systemThreads = std::min(4u, systemThreads);
-
     myWorkerThreads = systemThreads - 1;
     myTotalThreads  = systemThreads;
 
+    // The workers are started once and then woken up for every frame;
+    // the calling thread renders bands too, and isn't pinned, but core 0
+    // is left free for it
     myThreads = make_unique<std::thread[]>(myWorkerThreads);
+    for(uInt32 i = 0; i < myWorkerThreads; ++i)
+    {
+      myThreads[i] = std::thread([this] { workerThread(); });
+      if(affinity)
+        setAffinity(myThreads[i], i + 1);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::stopThreads()
+{
+  if(myWorkerThreads == 0)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(myPoolMutex);
+    myStopThreads = true;
+  }
+  myStartCondition.notify_all();
+
+  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+    myThreads[i].join();
+
+  myThreads.reset();
+  myWorkerThreads = 0;
+  myTotalThreads  = 1;
+  myStopThreads   = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::setAffinity(std::thread& thread, uInt32 core)
+{
+  const uInt32 cores = std::thread::hardware_concurrency();
+  if(cores == 0)
+    return;
+  core %= cores;
+
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core, &set);
+  pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#elif defined(BSPF_WINDOWS)
+  if(core < sizeof(DWORD_PTR) * 8)
+    SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core);
+#else
+  // Not supported; the scheduler decides
+  (void)thread;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::workerThread()
+{
+  uInt32 frame = 0;
+
+  for(;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(myPoolMutex);
+      myStartCondition.wait(lock, [&] {
+        return myStopThreads || myFrameCount != frame;
+      });
+      if(myStopThreads)
+        return;
+      frame = myFrameCount;
+    }
+
+    renderBands();
+
+    {
+      std::lock_guard<std::mutex> lock(myPoolMutex);
+      if(--myPendingThreads == 0)
+        myDoneCondition.notify_one();
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderBands()
+{
+  const RenderJob& job = myJob;
+  uInt32 band;
+
+  while((band = myNextBand++) < job.bands)
+  {
+    job.rgb_in == nullptr ?
+      renderThread(job.atari_in, job.in_width, job.in_height, job.bands, band,
+                   job.rgb_out, job.out_pitch) :
+      renderWithPhosphorThread(job.atari_in, job.in_width, job.in_height,
+                   job.bands, band, job.rgb_in, job.rgb_out, job.out_pitch);
   }
 }
 
@@ -90,28 +211,214 @@ void AtariNTSC::enableThreading(bool enable)
 void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
   void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
 {
-  // Spawn the threads...
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
+  if(myWorkerThreads == 0)
   {
-    myThreads[i] = std::thread([=] {
     rgb_in == nullptr ?
-      renderThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_out, out_pitch) :
-      renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_in, rgb_out, out_pitch);
-    });
+      renderThread(atari_in, in_width, in_height, 1, 0, rgb_out, out_pitch) :
+      renderWithPhosphorThread(atari_in, in_width, in_height, 1, 0, rgb_in, rgb_out, out_pitch);
+  }
+  else
+  {
+    // Split the frame into several row bands per thread, so that threads
+    // finishing early can pick up the remaining work
+    const uInt32 bands = std::min(in_height, myTotalThreads * 4);
+
+    // Wake up the workers...
+    {
+      std::lock_guard<std::mutex> lock(myPoolMutex);
+      myJob = { atari_in, in_width, in_height, rgb_out, out_pitch, rgb_in, bands };
+      myNextBand = 0;
+      myPendingThreads = myWorkerThreads;
+      ++myFrameCount;
+    }
+    myStartCondition.notify_all();
+
+    // Make the main thread busy too
+    renderBands();
+
+    // ...and wait until all of them are done
+    std::unique_lock<std::mutex> lock(myPoolMutex);
+    myDoneCondition.wait(lock, [&] { return myPendingThreads == 0; });
   }
-  // Make the main thread busy too
-  rgb_in == nullptr ?
-    renderThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_out, out_pitch) :
-    renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_in, rgb_out, out_pitch);
-  // ...and make them join again
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-    myThreads[i].join();
 
   // Copy phosphor values into out buffer
   if(rgb_in != nullptr)
     memcpy(rgb_out, rgb_in, in_height * out_pitch);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Each chunk turns two input pixels into seven output pixels. With C0/C1 the
+// kernels of the chunk's input pixels, P0/P1 those of the previous chunk and
+// PP1 the second input kernel of the chunk before that, the macros compute
+//   out[0..3] = C0[0..3] + P1[17..20] + P0[ 7..10] + PP1[24..27]
+//   out[4..6] = C0[4..6] + C1[14..16] + P0[11..13] + P1 [21..23]
+// Both halves are computed four (or eight) lanes at a time; the eighth lane
+// spills into the first pixel of the next chunk, which is rewritten later.
+struct AtariNTSC::SIMD
+{
+#ifdef ATARI_NTSC_X86
+  ATARI_NTSC_TARGET("sse2")
+  static inline __m128i clampSSE2(__m128i raw)
+  {
+    const __m128i mask = _mm_set1_epi32(atari_ntsc_clamp_mask);
+    const __m128i sub = _mm_and_si128(_mm_srli_epi32(raw, 9), mask);
+    __m128i clamp = _mm_sub_epi32(_mm_set1_epi32(atari_ntsc_clamp_add), sub);
+    raw = _mm_or_si128(raw, clamp);
+    clamp = _mm_sub_epi32(clamp, sub);
+    raw = _mm_and_si128(raw, clamp);
+
+    return _mm_or_si128(_mm_or_si128(
+      _mm_and_si128(_mm_srli_epi32(raw, 5), _mm_set1_epi32(0x00FF0000)),
+      _mm_and_si128(_mm_srli_epi32(raw, 3), _mm_set1_epi32(0x0000FF00))),
+      _mm_and_si128(_mm_srli_epi32(raw, 1), _mm_set1_epi32(0x000000FF)));
+  }
+
+  ATARI_NTSC_TARGET("sse2")
+  static void renderChunksSSE2(const uInt8* line_in, uInt32* line_out,
+      uInt32 chunks, const uInt32 (*table)[entry_size],
+      const uInt32*& kernel0, const uInt32*& kernel1,
+      const uInt32*& kernelx0, const uInt32*& kernelx1)
+  {
+    #define LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+
+    for(; chunks; --chunks, line_in += 2, line_out += 7)
+    {
+      const uInt32* const pp1 = kernelx1;
+      kernelx0 = kernel0;  kernel0 = table[line_in[0]];
+      kernelx1 = kernel1;  kernel1 = table[line_in[1]];
+
+      const __m128i lo = _mm_add_epi32(
+        _mm_add_epi32(LOAD(kernel0), LOAD(kernelx1 + 17)),
+        _mm_add_epi32(LOAD(kernelx0 + 7), LOAD(pp1 + 24)));
+      const __m128i hi = _mm_add_epi32(
+        _mm_add_epi32(LOAD(kernel0 + 4), LOAD(kernel1 + 14)),
+        _mm_add_epi32(LOAD(kernelx0 + 11), LOAD(kernelx1 + 21)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(line_out), clampSSE2(lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(line_out + 4), clampSSE2(hi));
+    }
+    #undef LOAD
+  }
+
+  ATARI_NTSC_TARGET("avx2")
+  static void renderChunksAVX2(const uInt8* line_in, uInt32* line_out,
+      uInt32 chunks, const uInt32 (*table)[entry_size],
+      const uInt32*& kernel0, const uInt32*& kernel1,
+      const uInt32*& kernelx0, const uInt32*& kernelx1)
+  {
+    #define LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+    #define LOAD2(lo, hi) \
+      _mm256_inserti128_si256(_mm256_castsi128_si256(LOAD(lo)), LOAD(hi), 1)
+
+    const __m256i mask = _mm256_set1_epi32(atari_ntsc_clamp_mask);
+    const __m256i add  = _mm256_set1_epi32(atari_ntsc_clamp_add);
+
+    for(; chunks; --chunks, line_in += 2, line_out += 7)
+    {
+      const uInt32* const pp1 = kernelx1;
+      kernelx0 = kernel0;  kernel0 = table[line_in[0]];
+      kernelx1 = kernel1;  kernel1 = table[line_in[1]];
+
+      // C0[0..7] and P0[7..14] are contiguous across both halves
+      __m256i raw = _mm256_add_epi32(
+        _mm256_add_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kernel0)),
+          LOAD2(kernelx1 + 17, kernel1 + 14)),
+        _mm256_add_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kernelx0 + 7)),
+          LOAD2(pp1 + 24, kernelx1 + 21)));
+
+      const __m256i sub = _mm256_and_si256(_mm256_srli_epi32(raw, 9), mask);
+      __m256i clamp = _mm256_sub_epi32(add, sub);
+      raw = _mm256_or_si256(raw, clamp);
+      clamp = _mm256_sub_epi32(clamp, sub);
+      raw = _mm256_and_si256(raw, clamp);
+
+      raw = _mm256_or_si256(_mm256_or_si256(
+        _mm256_and_si256(_mm256_srli_epi32(raw, 5), _mm256_set1_epi32(0x00FF0000)),
+        _mm256_and_si256(_mm256_srli_epi32(raw, 3), _mm256_set1_epi32(0x0000FF00))),
+        _mm256_and_si256(_mm256_srli_epi32(raw, 1), _mm256_set1_epi32(0x000000FF)));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(line_out), raw);
+    }
+    #undef LOAD2
+    #undef LOAD
+  }
+#endif
+
+#ifdef ATARI_NTSC_NEON
+  static inline uint32x4_t clampNEON(uint32x4_t raw)
+  {
+    const uint32x4_t sub = vandq_u32(vshrq_n_u32(raw, 9),
+                                     vdupq_n_u32(atari_ntsc_clamp_mask));
+    uint32x4_t clamp = vsubq_u32(vdupq_n_u32(atari_ntsc_clamp_add), sub);
+    raw = vorrq_u32(raw, clamp);
+    clamp = vsubq_u32(clamp, sub);
+    raw = vandq_u32(raw, clamp);
+
+    return vorrq_u32(vorrq_u32(
+      vandq_u32(vshrq_n_u32(raw, 5), vdupq_n_u32(0x00FF0000)),
+      vandq_u32(vshrq_n_u32(raw, 3), vdupq_n_u32(0x0000FF00))),
+      vandq_u32(vshrq_n_u32(raw, 1), vdupq_n_u32(0x000000FF)));
+  }
+
+  static void renderChunksNEON(const uInt8* line_in, uInt32* line_out,
+      uInt32 chunks, const uInt32 (*table)[entry_size],
+      const uInt32*& kernel0, const uInt32*& kernel1,
+      const uInt32*& kernelx0, const uInt32*& kernelx1)
+  {
+    for(; chunks; --chunks, line_in += 2, line_out += 7)
+    {
+      const uInt32* const pp1 = kernelx1;
+      kernelx0 = kernel0;  kernel0 = table[line_in[0]];
+      kernelx1 = kernel1;  kernel1 = table[line_in[1]];
+
+      const uint32x4_t lo = vaddq_u32(
+        vaddq_u32(vld1q_u32(kernel0), vld1q_u32(kernelx1 + 17)),
+        vaddq_u32(vld1q_u32(kernelx0 + 7), vld1q_u32(pp1 + 24)));
+      const uint32x4_t hi = vaddq_u32(
+        vaddq_u32(vld1q_u32(kernel0 + 4), vld1q_u32(kernel1 + 14)),
+        vaddq_u32(vld1q_u32(kernelx0 + 11), vld1q_u32(kernelx1 + 21)));
+
+      vst1q_u32(line_out, clampNEON(lo));
+      vst1q_u32(line_out + 4, clampNEON(hi));
+    }
+  }
+#endif
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AtariNTSC::ChunkRenderer AtariNTSC::detectChunkRenderer()
+{
+#if defined(ATARI_NTSC_X86) && defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  const int maxLeaf = info[0];
+
+  __cpuid(info, 1);
+  const bool sse2 = info[3] & (1 << 26);
+  // AVX2 also needs the OS to save the YMM registers
+  bool avx2 = false;
+  if(maxLeaf >= 7 && (info[2] & (1 << 27)) && (info[2] & (1 << 28)) &&
+     (_xgetbv(0) & 0x06) == 0x06)
+  {
+    __cpuidex(info, 7, 0);
+    avx2 = info[1] & (1 << 5);
+  }
+
+  if(avx2) return SIMD::renderChunksAVX2;
+  if(sse2) return SIMD::renderChunksSSE2;
+#elif defined(ATARI_NTSC_X86)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) return SIMD::renderChunksAVX2;
+  if(__builtin_cpu_supports("sse2")) return SIMD::renderChunksSSE2;
+#elif defined(ATARI_NTSC_NEON)
+  return SIMD::renderChunksNEON;
+#endif
+
+  return nullptr;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
   const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum,
@@ -132,7 +439,14 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
     uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
     ++line_in;
 
-    for(uInt32 n = chunk_count; n; --n)
+    if(myChunkRenderer)
+    {
+      myChunkRenderer(line_in, line_out, chunk_count, myColorTable,
+                      kernel0, kernel1, kernelx0, kernelx1);
+      line_in += 2 * chunk_count;
+      line_out += 7 * chunk_count;
+    }
+    else for(uInt32 n = chunk_count; n; --n)
     {
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0]);
@@ -205,7 +519,14 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
     uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
     ++line_in;
 
-    for(uInt32 n = chunk_count; n; --n)
+    if(myChunkRenderer)
+    {
+      myChunkRenderer(line_in, line_out, chunk_count, myColorTable,
+                      kernel0, kernel1, kernelx0, kernelx1);
+      line_in += 2 * chunk_count;
+      line_out += 7 * chunk_count;
+    }
+    else for(uInt32 n = chunk_count; n; --n)
     {
       // order of input and output pixels must not be altered
       ATARI_NTSC_COLOR_IN(0, line_in[0]);
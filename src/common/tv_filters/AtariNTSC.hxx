@@ -42,6 +42,9 @@
 
 #include <cmath>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 #include "bspf.hxx"
 
@@ -55,6 +58,7 @@ class AtariNTSC
 
     // By default, threading is turned off
     AtariNTSC() { enableThreading(false); }
+    ~AtariNTSC() { stopThreads(); }
 
     // Image parameters, ranging from -1.0 to 1.0. Actual internal values shown
     // in parenthesis and should remain fairly stable in future versions.
@@ -85,8 +89,12 @@ class AtariNTSC
     void initialize(const Setup& setup, const uInt8* palette);
     void initializePalette(const uInt8* palette);
 
-    // Set up threading
-    void enableThreading(bool enable);
+    // Set up threading; the worker threads are created here and stay alive
+    // until threading is reconfigured or the object is destroyed.
+    //  numThreads is the total number of rendering threads (including the
+    //  calling thread); 0 means one per available core.
+    //  affinity pins each worker thread to its own core, where supported.
+    void enableThreading(bool enable, uInt32 numThreads = 0, bool affinity = false);
 
     // Set phosphor palette, for use in Blargg + phosphor mode
     void setPhosphorPalette(uInt8 palette[256][256]) {
@@ -115,6 +123,30 @@ class AtariNTSC
     }
 
   private:
+    // Main loop of a worker thread; waits for a frame, then renders bands
+    void workerThread();
+    // Render bands of the current frame until none are left
+    void renderBands();
+    // Stop and join all worker threads
+    void stopThreads();
+    // Bind a worker thread to the given core
+    static void setAffinity(std::thread& thread, uInt32 core);
+
+    // Renders 'chunks' full chunks of a row and advances the kernel pointers
+    // exactly like the ATARI_NTSC_* macros do; the result is bit-exact with
+    // the scalar code
+    using ChunkRenderer = void (*)(const uInt8* line_in, uInt32* line_out,
+        uInt32 chunks, const uInt32 (*table)[entry_size],
+        const uInt32*& kernel0, const uInt32*& kernel1,
+        const uInt32*& kernelx0, const uInt32*& kernelx1);
+
+    // SIMD implementations of ChunkRenderer (defined in the .cxx file)
+    struct SIMD;
+
+    // Select the fastest ChunkRenderer supported by the CPU, or nullptr to
+    // use the scalar code
+    static ChunkRenderer detectChunkRenderer();
+
     // Threaded rendering
     void renderThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, void* rgb_out, const uInt32 out_pitch);
@@ -170,10 +202,34 @@ class AtariNTSC
     uInt32 myColorTable[palette_size][entry_size];
     uInt8 myPhosphorPalette[256][256];
 
+    // Vectorized inner loop of the renderers (nullptr = scalar)
+    ChunkRenderer myChunkRenderer{detectChunkRenderer()};
+
     // Rendering threads
     unique_ptr<std::thread[]> myThreads;
     // Number of rendering and total threads
-    uInt32 myWorkerThreads, myTotalThreads;
+    uInt32 myWorkerThreads{0}, myTotalThreads{1};
+
+    // Frame currently being rendered by the thread pool
+    struct RenderJob
+    {
+      const uInt8* atari_in;
+      uInt32 in_width, in_height;
+      void* rgb_out;
+      uInt32 out_pitch;
+      uInt32* rgb_in;
+      uInt32 bands;
+    };
+    RenderJob myJob;
+
+    // Barrier between render() and the worker threads
+    std::mutex myPoolMutex;
+    std::condition_variable myStartCondition, myDoneCondition;
+    uInt32 myFrameCount{0};       // incremented to wake up the workers
+    uInt32 myPendingThreads{0};   // workers still busy with the current frame
+    bool myStopThreads{false};
+    // Next row band to be rendered by any thread
+    std::atomic<uInt32> myNextBand;
 
     struct init_t
     {
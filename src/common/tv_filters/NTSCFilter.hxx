@@ -109,21 +109,21 @@ class NTSCFilter
 
     // Perform Blargg filtering on input buffer, place results in
     // output buffer
-    inline void render(uInt8* src_buf, uInt32 src_width, uInt32 src_height,
+    inline void render(const uInt8* src_buf, uInt32 src_width, uInt32 src_height,
                        uInt32* dest_buf, uInt32 dest_pitch)
     {
       myNTSC.render(src_buf, src_width, src_height, dest_buf, dest_pitch);
     }
-    inline void render(uInt8* src_buf, uInt32 src_width, uInt32 src_height,
+    inline void render(const uInt8* src_buf, uInt32 src_width, uInt32 src_height,
                        uInt32* dest_buf, uInt32 dest_pitch, uInt32* prev_buf)
     {
       myNTSC.render(src_buf, src_width, src_height, dest_buf, dest_pitch, prev_buf);
     }
 
     // Enable threading for the NTSC rendering
-    inline void enableThreading(bool enable)
+    inline void enableThreading(bool enable, uInt32 numThreads = 0, bool affinity = false)
     {
-      myNTSC.enableThreading(enable);
+      myNTSC.enableThreading(enable, numThreads, affinity);
     }
 
   private:
@@ -74,6 +74,9 @@ Debugger::Debugger(OSystem& osystem, Console& console)
   myRiotDebug = make_unique<RiotDebug>(*this, myConsole);
   myTiaDebug  = make_unique<TIADebug>(*this, myConsole);
 
+  // Normally, access flags are only tracked once the debugger is entered
+  mySystem.setAccessTracking(osystem.settings().getBool("dis.trackaccess"));
+
   // Allow access to this object from any class
   // Technically this violates pure OO programming, but since I know
   // there will only be ever one instance of debugger in Stella,
@@ -618,6 +621,9 @@ void Debugger::setStartState()
   // Lock the bus each time the debugger is entered, so we don't disturb anything
   lockBankswitchState();
 
+  // From now on, keep track of code/data accesses for the disassembler
+  mySystem.setAccessTracking(true);
+
   RewindManager& r = myOSystem.state().rewindManager();
   updateRewindbuttons(r);
 
@@ -20,10 +20,11 @@
 #include "AtariVox.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-AtariVox::AtariVox(Jack jack, const Event& event, const System& system,
+AtariVox::AtariVox(Jack jack, const Event& event, System& system,
                    const SerialPort& port, const string& portname,
                    const string& eepromfile)
   : SaveKey(jack, event, system, eepromfile, Controller::AtariVox),
+    myScheduler(system),
     mySerialPort(const_cast<SerialPort&>(port)),
     myShiftCount(0),
     myShiftRegister(0),
@@ -37,6 +38,12 @@ AtariVox::AtariVox(Jack jack, const Event& event, const System& system,
   myDigitalPinState[Three] = myDigitalPinState[Four] = true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AtariVox::~AtariVox()
+{
+  myScheduler.clearDeadline(*this);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool AtariVox::read(DigitalPin pin)
 {
@@ -79,10 +86,10 @@ void AtariVox::clockDataIn(bool value)
   if(value && (myShiftCount == 0))
     return;
 
-  // If this is the first write this frame, or if it's been a long time
-  // since the last write, start a new data byte.
+  // If this is the first write this frame, start a new data byte.  If it's
+  // been a long time since the last write, deadlineReached() already did.
   uInt64 cycle = mySystem.cycles();
-  if((cycle < myLastDataWriteCycle) || (cycle > myLastDataWriteCycle + 1000))
+  if(cycle < myLastDataWriteCycle)
   {
     myShiftRegister = 0;
     myShiftCount = 0;
@@ -112,11 +119,27 @@ void AtariVox::clockDataIn(bool value)
   }
 
   myLastDataWriteCycle = cycle;
+
+  // Drop a partially received byte if the next bit doesn't follow soon
+  if(myShiftCount > 0)
+    myScheduler.setDeadline(*this, cycle + 1001);
+  else
+    myScheduler.clearDeadline(*this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariVox::deadlineReached()
+{
+  myShiftRegister = 0;
+  myShiftCount = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariVox::reset()
 {
   myLastDataWriteCycle = 0;
+  myShiftRegister = 0;
+  myShiftCount = 0;
+  myScheduler.clearDeadline(*this);
   SaveKey::reset();
 }
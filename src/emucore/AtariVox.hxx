@@ -21,6 +21,7 @@
 class SerialPort;
 
 #include "Control.hxx"
+#include "DeadlineListener.hxx"
 #include "SaveKey.hxx"
 
 /**
@@ -32,7 +33,7 @@ class SerialPort;
 
   @author  B. Watson
 */
-class AtariVox : public SaveKey
+class AtariVox : public SaveKey, public DeadlineListener
 {
   public:
     /**
@@ -45,10 +46,10 @@ class AtariVox : public SaveKey
       @param portname   Name of the port used for reading and writing
       @param eepromfile The file containing the EEPROM data
     */
-    AtariVox(Jack jack, const Event& event, const System& system,
+    AtariVox(Jack jack, const Event& event, System& system,
              const SerialPort& port, const string& portname,
              const string& eepromfile);
-    virtual ~AtariVox() = default;
+    virtual ~AtariVox();
 
   public:
     using Controller::read;
@@ -86,10 +87,19 @@ class AtariVox : public SaveKey
 
     string about(bool swappedPorts) const override { return Controller::about(swappedPorts) + myAboutString; }
 
+    /**
+      Called by the system when no data bit has been written for too long,
+      to drop the partially received byte.
+    */
+    void deadlineReached() override;
+
   private:
    void clockDataIn(bool value);
 
   private:
+    // The system, which notifies us when a data byte times out
+    System& myScheduler;
+
     // Instance of an real serial port on the system
     // Assuming there's a real AtariVox attached, we can send SpeakJet
     // bytes directly to it
@@ -30,7 +30,9 @@ Cartridge::Cartridge(const Settings& settings)
     myStartBank(0),
     myBankChanged(true),
     myCodeAccessBase(nullptr),
-    myBankLocked(false)
+    myBankLocked(false),
+    myBankPagesStart(0),
+    myBankPagesCount(0)
 {
 }
 
@@ -117,3 +119,19 @@ bool Cartridge::randomStartBank() const
   return mySettings.getBool(mySettings.getBool("dev.settings") ? "dev.bankrandom" : "plr.bankrandom");
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::createBankPages(uInt16 banks, uInt16 start, uInt16 size)
+{
+  myBankPagesStart = start;
+  myBankPagesCount = size >> System::PAGE_SHIFT;
+  myBankPages.assign(banks * myBankPagesCount, System::PageAccess());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::setBankPageAccess(uInt16 bank, uInt16 addr,
+                                  const System::PageAccess& access)
+{
+  myBankPages[bank * myBankPagesCount +
+              ((addr - myBankPagesStart) >> System::PAGE_SHIFT)] = access;
+}
+
@@ -26,6 +26,7 @@ class GuiObject;
 
 #include "bspf.hxx"
 #include "Device.hxx"
+#include "System.hxx"
 #include "Settings.hxx"
 #include "Font.hxx"
 
@@ -215,6 +216,32 @@ class Cartridge : public Device
     */
     bool randomStartBank() const;
 
+    /**
+      Schemes that always map a bank into the same segment of the address
+      space precompute the page access entries for every bank when they
+      are installed.  A bankswitch then only copies the entries of the new
+      bank into the system's page table (see installBankPages()).
+
+      @param banks  The number of banks
+      @param start  The address of the first page of the segment
+      @param size   The size of the segment in bytes
+    */
+    void createBankPages(uInt16 banks, uInt16 start, uInt16 size);
+
+    /**
+      Set the precomputed page access entry for the given address in
+      the given bank.
+    */
+    void setBankPageAccess(uInt16 bank, uInt16 addr, const System::PageAccess& access);
+
+    /**
+      Map the precomputed pages of the given bank into the system.
+    */
+    void installBankPages(uInt16 bank) {
+      mySystem->setPageAccess(myBankPagesStart,
+          &myBankPages[bank * myBankPagesCount], myBankPagesCount);
+    }
+
   protected:
     // Settings class for the application
     const Settings& mySettings;
@@ -240,6 +267,11 @@ class Cartridge : public Device
     // (ie, detected type could be '2in1' while name of cart is '4K')
     string myAbout, myDetectedType, myMultiCartID;
 
+    // The precomputed page access entries of all banks, and the segment
+    // they map to
+    vector<System::PageAccess> myBankPages;
+    uInt16 myBankPagesStart, myBankPagesCount;
+
     // Following constructors and assignment operators not supported
     Cartridge() = delete;
     Cartridge(const Cartridge&) = delete;
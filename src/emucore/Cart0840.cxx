@@ -60,6 +60,24 @@ void Cartridge0840::install(System& system)
   for(uInt16 addr = 0x0800; addr < 0x0FFF; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Precompute the page access entries for every bank
+  createBankPages(bankCount(), 0x1000, 0x1000);
+  for(uInt16 b = 0; b < bankCount(); ++b)
+  {
+    const uInt16 offset = b << 12;
+
+    // Setup the page access methods for this bank
+    System::PageAccess access(this, System::PA_READ);
+
+    // Map this bank of the ROM image into the system
+    for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myImage[offset + (addr & 0x0FFF)];
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+  }
+
   // Install pages for bank 0
   bank(myStartBank);
 }
@@ -133,16 +151,8 @@ bool Cartridge0840::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-
-  // Map ROM image into the system
-  for(uInt16 addr = 0x1000; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the precomputed pages of the new bank
+  installBankPages(bank);
   return myBankChanged = true;
 }
 
@@ -44,6 +44,32 @@ void CartridgeBF::install(System& system)
 {
   mySystem = &system;
 
+  // Precompute the page access entries for every bank
+  createBankPages(bankCount(), 0x1000, 0x1000);
+  for(uInt16 b = 0; b < bankCount(); ++b)
+  {
+    const uInt16 offset = b << 12;
+
+    System::PageAccess access(this, System::PA_READ);
+
+    // Set the page accessing methods for the hot spots
+    for(uInt16 addr = (0x1F80 & ~System::PAGE_MASK); addr < 0x2000;
+        addr += System::PAGE_SIZE)
+    {
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+
+    // Setup the page access methods for the current bank
+    for(uInt16 addr = 0x1000; addr < (0x1F80U & ~System::PAGE_MASK);
+        addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myImage[offset + (addr & 0x0FFF)];
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+  }
+
   // Install pages for the startup bank
   bank(myStartBank);
 }
@@ -84,24 +110,8 @@ bool CartridgeBF::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PA_READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1F80 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1000; addr < (0x1F80U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the precomputed pages of the new bank
+  installBankPages(bank);
   return myBankChanged = true;
 }
 
@@ -43,9 +43,7 @@
 CartridgeBUS::CartridgeBUS(const BytePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
-    myAudioCycles(0),
-    myARMCycles(0),
-    myFractionalClocks(0.0)
+    myAudioClock(20000 * 3, 3579575)  // 20 kHz from the 1193191.67 Hz CPU clock
 {
   // Copy the ROM image into my buffer
   memcpy(myImage, image.get(), std::min(32768u, size));
@@ -78,8 +76,8 @@ void CartridgeBUS::reset()
   initializeRAM(myBUSRAM+2048, 8192-2048);
 
   // Update cycles to the current system cycles
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myAudioClock.reset();
+  myARMClock.reset();
 
   setInitialState();
 
@@ -132,14 +130,8 @@ void CartridgeBUS::install(System& system)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeBUS::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
   // Calculate the number of BUS OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myAudioClock.update(mySystem->cycles());
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -157,8 +149,7 @@ inline void CartridgeBUS::callFunction(uInt8 value)
               // time for Stella as ARM code "runs in zero 6507 cycles".
     case 255: // call without IRQ driven audio
       try {
-        Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
-        myARMCycles = mySystem->cycles();
+        Int32 cycles = Int32(myARMClock.update(mySystem->cycles()));
 
         myThumbEmulator->run(cycles);
       }
@@ -553,10 +544,9 @@ bool CartridgeBUS::save(Serializer& out) const
     out.putShort(mySTYZeroPageAddress);
     out.putShort(myJMPoperandAddress);
 
-    // Save cycles and clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
-    out.putLong(myARMCycles);
+    // Save the music and ARM clocks
+    myAudioClock.save(out);
+    myARMClock.save(out);
 
     // Audio info
     out.putIntArray(myMusicCounters, 3);
@@ -597,10 +587,9 @@ bool CartridgeBUS::load(Serializer& in)
     mySTYZeroPageAddress = in.getShort();
     myJMPoperandAddress = in.getShort();
 
-    // Get system cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
-    myARMCycles = in.getLong();
+    // Get the music and ARM clocks
+    myAudioClock.load(in);
+    myARMClock.load(in);
 
     // Audio info
     in.getIntArray(myMusicCounters, 3);
@@ -26,6 +26,7 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "DeviceClock.hxx"
 
 /**
   Cartridge class used for BUS.
@@ -240,11 +241,11 @@ class CartridgeBUS : public Cartridge
     // *and* the next two bytes in ROM are 00 00
     uInt16 myJMPoperandAddress;
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles;
+    // The music OSC clock, updated when the music data fetchers are accessed
+    DeviceClock myAudioClock;
 
-    // ARM cycle count from when the last callFunction() occurred
-    uInt64 myARMCycles;
+    // System cycles passed to Thumbulator::run() since the last callFunction()
+    DeviceClock myARMClock;
 
     // The music mode counters
     uInt32 myMusicCounters[3];
@@ -255,9 +256,6 @@ class CartridgeBUS : public Cartridge
     // The music waveform sizes
     uInt8 myMusicWaveformSize[3];
 
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
-
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Bus Stuffing ON
     // -F = Bus Stuffing OFF
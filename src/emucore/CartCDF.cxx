@@ -44,9 +44,7 @@ const uInt16 WAVEFORM[] = {0x07F0, 0x01B0};
 CartridgeCDF::CartridgeCDF(const BytePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
-    myAudioCycles(0),
-    myARMCycles(0),
-    myFractionalClocks(0.0)
+    myAudioClock(20000 * 3, 3579575)  // 20 kHz from the 1193191.67 Hz CPU clock
 {
   // Copy the ROM image into my buffer
   memcpy(myImage, image.get(), std::min(32768u, size));
@@ -80,8 +78,8 @@ void CartridgeCDF::reset()
 {
   initializeRAM(myCDFRAM+2048, 8192-2048);
 
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myAudioClock.reset();
+  myARMClock.reset();
 
   setInitialState();
 
@@ -131,14 +129,8 @@ void CartridgeCDF::install(System& system)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeCDF::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
   // Calculate the number of CDF OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myAudioClock.update(mySystem->cycles());
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -156,8 +148,7 @@ inline void CartridgeCDF::callFunction(uInt8 value)
               // time for Stella as ARM code "runs in zero 6507 cycles".
     case 255: // call without IRQ driven audio
       try {
-        Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
-        myARMCycles = mySystem->cycles();
+        Int32 cycles = Int32(myARMClock.update(mySystem->cycles()));
 
         myThumbEmulator->run(cycles);
       }
@@ -499,10 +490,9 @@ bool CartridgeCDF::save(Serializer& out) const
     out.putIntArray(myMusicFrequencies, 3);
     out.putByteArray(myMusicWaveformSize, 3);
 
-    // Save cycles and clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
-    out.putLong(myARMCycles);
+    // Save the music and ARM clocks
+    myAudioClock.save(out);
+    myARMClock.save(out);
   }
   catch(...)
   {
@@ -542,10 +532,9 @@ bool CartridgeCDF::load(Serializer& in)
     in.getIntArray(myMusicFrequencies, 3);
     in.getByteArray(myMusicWaveformSize, 3);
 
-    // Get cycles and clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
-    myARMCycles = in.getLong();
+    // Get the music and ARM clocks
+    myAudioClock.load(in);
+    myARMClock.load(in);
   }
   catch(...)
   {
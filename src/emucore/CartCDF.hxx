@@ -26,6 +26,7 @@ class Thumbulator;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "DeviceClock.hxx"
 
 /**
   Cartridge class used for CDF.
@@ -225,11 +226,11 @@ class CartridgeCDF : public Cartridge
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles;
+    // The music OSC clock, updated when the music data fetchers are accessed
+    DeviceClock myAudioClock;
 
-    // ARM cycle count from when the last callFunction() occurred
-    uInt64 myARMCycles;
+    // System cycles passed to Thumbulator::run() since the last callFunction()
+    DeviceClock myARMClock;
 
     // The audio routines in the driver run in 32-bit mode and take advantage
     // of the FIQ Shadow Registers which are not accessible to 16-bit thumb
@@ -256,9 +257,6 @@ class CartridgeCDF : public Cartridge
     // The music waveform sizes
     uInt8 myMusicWaveformSize[3];
 
-    // Fractional CDF music, OSC clocks unused during the last update
-    double myFractionalClocks;
-
     // Controls mode, lower nybble sets Fast Fetch, upper nybble sets audio
     // -0 = Fast Fetch ON
     // -F = Fast Fetch OFF
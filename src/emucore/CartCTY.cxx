@@ -70,6 +70,21 @@ void CartridgeCTY::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1080; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Precompute the page access entries for every bank
+  createBankPages(bankCount(), 0x1080, 0x0F80);
+  for(uInt16 b = 0; b < bankCount(); ++b)
+  {
+    const uInt16 offset = b << 12;
+
+    // Setup the page access methods for this bank
+    System::PageAccess access(this, System::PA_READ);
+    for(uInt16 addr = 0x1080; addr < 0x2000; addr += System::PAGE_SIZE)
+    {
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+  }
+
   // Install pages for the startup bank
   bank(myStartBank);
 }
@@ -227,13 +242,8 @@ bool CartridgeCTY::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  // Setup the page access methods for the current bank
-  System::PageAccess access(this, System::PA_READ);
-  for(uInt16 addr = 0x1080; addr < 0x2000; addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the precomputed pages of the new bank
+  installBankPages(bank);
   return myBankChanged = true;
 }
 
@@ -67,6 +67,32 @@ void CartridgeDFSC::install(System& system)
     mySystem->setPageAccess(addr, access);
   }
 
+  // Precompute the page access entries for every bank
+  createBankPages(bankCount(), 0x1100, 0x0F00);
+  for(uInt16 b = 0; b < bankCount(); ++b)
+  {
+    const uInt16 offset = b << 12;
+
+    System::PageAccess access(this, System::PA_READ);
+
+    // Set the page accessing methods for the hot spots
+    for(uInt16 addr = (0x1FC0 & ~System::PAGE_MASK); addr < 0x2000;
+        addr += System::PAGE_SIZE)
+    {
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+
+    // Setup the page access methods for the current bank
+    for(uInt16 addr = 0x1100; addr < (0x1FC0U & ~System::PAGE_MASK);
+        addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myImage[offset + (addr & 0x0FFF)];
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+  }
+
   // Install pages for the startup bank
   bank(myStartBank);
 }
@@ -121,24 +147,8 @@ bool CartridgeDFSC::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PA_READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1FC0 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1100; addr < (0x1FC0U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the precomputed pages of the new bank
+  installBankPages(bank);
   return myBankChanged = true;
 }
 
@@ -23,8 +23,7 @@ CartridgeDPC::CartridgeDPC(const BytePtr& image, uInt32 size,
                            const Settings& settings)
   : Cartridge(settings),
     mySize(size),
-    myAudioCycles(0),
-    myFractionalClocks(0.0),
+    myAudioClock(20000 * 3, 3579575),  // 20 kHz from the 1193191.67 Hz CPU clock
     myBankOffset(0)
 {
   // Make a copy of the entire image
@@ -54,8 +53,7 @@ CartridgeDPC::CartridgeDPC(const BytePtr& image, uInt32 size,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeDPC::reset()
 {
-  myAudioCycles = 0;
-  myFractionalClocks = 0.0;
+  myAudioClock.reset();
 
   // define random startup bank
   randomizeStartBank();
@@ -74,6 +72,32 @@ void CartridgeDPC::install(System& system)
   for(uInt16 addr = 0x1000; addr < 0x1080; addr += System::PAGE_SIZE)
     mySystem->setPageAccess(addr, access);
 
+  // Precompute the page access entries for every bank
+  createBankPages(bankCount(), 0x1080, 0x0F80);
+  for(uInt16 b = 0; b < bankCount(); ++b)
+  {
+    const uInt16 offset = b << 12;
+
+    System::PageAccess access(this, System::PA_READ);
+
+    // Set the page accessing methods for the hot spots
+    for(uInt16 addr = (0x1FF8 & ~System::PAGE_MASK); addr < 0x2000;
+        addr += System::PAGE_SIZE)
+    {
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+
+    // Setup the page access methods for the current bank
+    for(uInt16 addr = 0x1080; addr < (0x1FF8U & ~System::PAGE_MASK);
+        addr += System::PAGE_SIZE)
+    {
+      access.directPeekBase = &myProgramImage[offset + (addr & 0x0FFF)];
+      access.codeAccessBase = &myCodeAccessBase[offset + (addr & 0x0FFF)];
+      setBankPageAccess(b, addr, access);
+    }
+  }
+
   // Install pages for the startup bank
   bank(myStartBank);
 }
@@ -99,14 +123,8 @@ inline void CartridgeDPC::clockRandomNumberGenerator()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeDPC::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
   // Calculate the number of DPC OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myAudioClock.update(mySystem->cycles());
 
   if(wholeClocks <= 0)
     return;
@@ -382,24 +400,8 @@ bool CartridgeDPC::bank(uInt16 bank)
   // Remember what bank we're in
   myBankOffset = bank << 12;
 
-  System::PageAccess access(this, System::PA_READ);
-
-  // Set the page accessing methods for the hot spots
-  for(uInt16 addr = (0x1FF8 & ~System::PAGE_MASK); addr < 0x2000;
-      addr += System::PAGE_SIZE)
-  {
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
-
-  // Setup the page access methods for the current bank
-  for(uInt16 addr = 0x1080; addr < (0x1FF8U & ~System::PAGE_MASK);
-      addr += System::PAGE_SIZE)
-  {
-    access.directPeekBase = &myProgramImage[myBankOffset + (addr & 0x0FFF)];
-    access.codeAccessBase = &myCodeAccessBase[myBankOffset + (addr & 0x0FFF)];
-    mySystem->setPageAccess(addr, access);
-  }
+  // Map the precomputed pages of the new bank
+  installBankPages(bank);
   return myBankChanged = true;
 }
 
@@ -466,8 +468,7 @@ bool CartridgeDPC::save(Serializer& out) const
     // The random number generator register
     out.putByte(myRandomNumber);
 
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    myAudioClock.save(out);
   }
   catch(...)
   {
@@ -508,9 +509,8 @@ bool CartridgeDPC::load(Serializer& in)
     // The random number generator register
     myRandomNumber = in.getByte();
 
-    // Get system cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    // Get the music clock
+    myAudioClock.load(in);
   }
   catch(...)
   {
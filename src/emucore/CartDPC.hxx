@@ -22,6 +22,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "DeviceClock.hxx"
 #ifdef DEBUGGER_SUPPORT
   #include "CartDPCWidget.hxx"
 #endif
@@ -195,11 +196,8 @@ class CartridgeDPC : public Cartridge
     // The random number generator register
     uInt8 myRandomNumber;
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles;
-
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // The music OSC clock, updated when the music data fetchers are accessed
+    DeviceClock myAudioClock;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
@@ -30,9 +30,7 @@ CartridgeDPCPlus::CartridgeDPCPlus(const BytePtr& image, uInt32 size,
     myFastFetch(false),
     myLDAimmediate(false),
     myParameterPointer(0),
-    myAudioCycles(0),
-    myARMCycles(0),
-    myFractionalClocks(0.0),
+    myAudioClock(20000 * 3, 3579575),  // 20 kHz from the 1193191.67 Hz CPU clock
     myBankOffset(0)
 {
   // Image is always 32K, but in the case of ROM > 29K, the image is
@@ -69,8 +67,8 @@ CartridgeDPCPlus::CartridgeDPCPlus(const BytePtr& image, uInt32 size,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CartridgeDPCPlus::reset()
 {
-  myAudioCycles = myARMCycles = 0;
-  myFractionalClocks = 0.0;
+  myAudioClock.reset();
+  myARMClock.reset();
 
   setInitialState();
 
@@ -139,14 +137,8 @@ inline void CartridgeDPCPlus::priorClockRandomNumberGenerator()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline void CartridgeDPCPlus::updateMusicModeDataFetchers()
 {
-  // Calculate the number of cycles since the last update
-  uInt32 cycles = uInt32(mySystem->cycles() - myAudioCycles);
-  myAudioCycles = mySystem->cycles();
-
   // Calculate the number of DPC+ OSC clocks since the last update
-  double clocks = ((20000.0 * cycles) / 1193191.66666667) + myFractionalClocks;
-  uInt32 wholeClocks = uInt32(clocks);
-  myFractionalClocks = clocks - double(wholeClocks);
+  uInt32 wholeClocks = myAudioClock.update(mySystem->cycles());
 
   // Let's update counters and flags of the music mode data fetchers
   if(wholeClocks > 0)
@@ -179,8 +171,7 @@ inline void CartridgeDPCPlus::callFunction(uInt8 value)
               // time for Stella as ARM code "runs in zero 6507 cycles".
     case 255: // call without IRQ driven audio
       try {
-        Int32 cycles = Int32(mySystem->cycles() - myARMCycles);
-        myARMCycles = mySystem->cycles();
+        Int32 cycles = Int32(myARMClock.update(mySystem->cycles()));
 
         myThumbEmulator->run(cycles);
       }
@@ -671,12 +662,11 @@ bool CartridgeDPCPlus::save(Serializer& out) const
     // The random number generator register
     out.putInt(myRandomNumber);
 
-    // Get system cycles and fractional clocks
-    out.putLong(myAudioCycles);
-    out.putDouble(myFractionalClocks);
+    // Save the music and ARM clocks
+    myAudioClock.save(out);
 
     // Clock info for Thumbulator
-    out.putLong(myARMCycles);
+    myARMClock.save(out);
   }
   catch(...)
   {
@@ -735,12 +725,11 @@ bool CartridgeDPCPlus::load(Serializer& in)
     // The random number generator register
     myRandomNumber = in.getInt();
 
-    // Get audio cycles and fractional clocks
-    myAudioCycles = in.getLong();
-    myFractionalClocks = in.getDouble();
+    // Get the music and ARM clocks
+    myAudioClock.load(in);
 
     // Clock info for Thumbulator
-    myARMCycles = in.getLong();
+    myARMClock.load(in);
   }
   catch(...)
   {
@@ -27,6 +27,7 @@ class System;
 
 #include "bspf.hxx"
 #include "Cart.hxx"
+#include "DeviceClock.hxx"
 
 /**
   Cartridge class used for DPC+, derived from Pitfall II.  There are six 4K
@@ -256,14 +257,11 @@ class CartridgeDPCPlus : public Cartridge
     // The random number generator register
     uInt32 myRandomNumber;
 
-    // System cycle count from when the last update to music data fetchers occurred
-    uInt64 myAudioCycles;
+    // The music OSC clock, updated when the music data fetchers are accessed
+    DeviceClock myAudioClock;
 
-    // System cycle count when the last Thumbulator::run() occurred
-    uInt64 myARMCycles;
-
-    // Fractional DPC music OSC clocks unused during the last update
-    double myFractionalClocks;
+    // System cycles passed to Thumbulator::run() since the last callFunction()
+    DeviceClock myARMClock;
 
     // Indicates the offset into the ROM image (aligns to current bank)
     uInt16 myBankOffset;
@@ -0,0 +1,50 @@
+//============================================================================
+//
+// MM     MM  6666  555555  0000   2222
+// MMMM MMMM 66  66 55     00  00 22  22
+// MM MMM MM 66     55     00  00     22
+// MM  M  MM 66666  55555  00  00  22222  --  "A 6502 Microprocessor Emulator"
+// MM     MM 66  66     55 00  00 22
+// MM     MM 66  66 55  55 00  00 22
+// MM     MM  6666   5555   0000  222222
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef DEADLINE_LISTENER_HXX
+#define DEADLINE_LISTENER_HXX
+
+/**
+  Devices normally catch up with the system clock only when they are
+  accessed.  A device which has something to do at a known system cycle,
+  whether or not it is accessed by then, implements this interface and
+  registers that cycle with System::setDeadline().
+
+  @author  Stephen Anthony
+*/
+class DeadlineListener
+{
+  public:
+    DeadlineListener() = default;
+    virtual ~DeadlineListener() = default;
+
+    /**
+      Called by the system once its cycle counter reaches the registered
+      deadline.  The deadline is cleared before the call, so the listener
+      may register a new one from here.
+    */
+    virtual void deadlineReached() = 0;
+
+  private:
+    // Following constructors and assignment operators not supported
+    DeadlineListener(const DeadlineListener&) = delete;
+    DeadlineListener(DeadlineListener&&) = delete;
+    DeadlineListener& operator=(const DeadlineListener&) = delete;
+    DeadlineListener& operator=(DeadlineListener&&) = delete;
+};
+
+#endif
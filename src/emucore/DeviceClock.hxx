@@ -0,0 +1,92 @@
+//============================================================================
+//
+// MM     MM  6666  555555  0000   2222
+// MMMM MMMM 66  66 55     00  00 22  22
+// MM MMM MM 66     55     00  00     22
+// MM  M  MM 66666  55555  00  00  22222  --  "A 6502 Microprocessor Emulator"
+// MM     MM 66  66     55 00  00 22
+// MM     MM 66  66 55  55 00  00 22
+// MM     MM  6666   5555   0000  222222
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef DEVICE_CLOCK_HXX
+#define DEVICE_CLOCK_HXX
+
+#include "Serializer.hxx"
+#include "bspf.hxx"
+
+/**
+  Devices with their own clock (for example the music data fetchers of the
+  DPC family) only catch up with the system when they are accessed.  This
+  class converts the system cycles that have passed since the last update
+  into ticks of the device clock, which runs at multiplier / divider times
+  the system clock.  The remainder is kept as an integer, so no rounding
+  errors accumulate over time.
+
+  @author  Stephen Anthony
+*/
+class DeviceClock
+{
+  public:
+    DeviceClock(uInt32 multiplier = 1, uInt32 divider = 1)
+      : myMultiplier(multiplier),
+        myDivider(divider),
+        myLastCycle(0),
+        myRemainder(0) { }
+
+    /**
+      Restart the clock at the given system cycle.
+    */
+    void reset(uInt64 cycle = 0)
+    {
+      myLastCycle = cycle;
+      myRemainder = 0;
+    }
+
+    /**
+      Advance the clock to the given system cycle.
+
+      @return  The number of device clocks since the last update
+    */
+    uInt32 update(uInt64 cycle)
+    {
+      const uInt64 ticks = (cycle - myLastCycle) * myMultiplier + myRemainder;
+
+      myLastCycle = cycle;
+      myRemainder = uInt32(ticks % myDivider);
+
+      return uInt32(ticks / myDivider);
+    }
+
+    /**
+      Save/load the clock state; called from the owning device.
+    */
+    void save(Serializer& out) const
+    {
+      out.putLong(myLastCycle);
+      out.putInt(myRemainder);
+    }
+    void load(Serializer& in)
+    {
+      myLastCycle = in.getLong();
+      myRemainder = in.getInt();
+    }
+
+  private:
+    uInt32 myMultiplier, myDivider;
+
+    // System cycle of the last update
+    uInt64 myLastCycle;
+
+    // Fraction of a device clock left over from the last update, in units
+    // of 1 / myDivider
+    uInt32 myRemainder;
+};
+
+#endif
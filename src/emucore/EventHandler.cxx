@@ -40,6 +40,7 @@
 #include "Settings.hxx"
 #include "Sound.hxx"
 #include "StateManager.hxx"
+#include "CaptureManager.hxx"
 #include "Switches.hxx"
 #include "M6532.hxx"
 #include "MouseControl.hxx"
@@ -63,6 +64,7 @@ EventHandler::EventHandler(OSystem& osystem)
     myState(S_NONE),
     myAllowAllDirectionsFlag(false),
     myFryingFlag(false),
+    myFastForwardFlag(false),
     myUseCtrlKeyFlag(true),
     mySkipMouseMotion(true),
     myIs7800(false),
@@ -393,6 +395,7 @@ void EventHandler::handleKeyEvent(StellaKey key, StellaMod mod, bool state)
         case KBDK_0:  // Alt-0 changes custom adjustables for NTSC filtering
           if(myOSystem.frameBuffer().tiaSurface().ntscEnabled())
           {
+            myOSystem.frameBuffer().tiaSurface().invalidate();
             if(mod & KBDM_SHIFT)
               myOSystem.frameBuffer().showMessage(
                   myOSystem.frameBuffer().tiaSurface().ntsc().decreaseAdjustable());
@@ -479,6 +482,10 @@ void EventHandler::handleKeyEvent(StellaKey key, StellaMod mod, bool state)
           myOSystem.state().toggleRewindMode();
           break;
 
+        case KBDK_K:  // Alt-k toggles recording video and sound
+          myOSystem.capture().toggleRecording();
+          break;
+
         case KBDK_S:
           if(myContSnapshotInterval == 0)
           {
@@ -888,6 +895,7 @@ void EventHandler::handleSystemEvent(SystemEvent e, int, int)
   switch(e)
   {
     case EVENT_WINDOW_EXPOSED:
+      myOSystem.frameBuffer().tiaSurface().invalidate();
       myOSystem.frameBuffer().update();
       break;
 
@@ -962,6 +970,16 @@ void EventHandler::handleEvent(Event::Type event, int state)
       if(myUseCtrlKeyFlag) myFryingFlag = bool(state);
       return;
 
+    case Event::FastForward:
+      if(state && myState == S_EMULATE)
+      {
+        myFastForwardFlag = !myFastForwardFlag;
+        myOSystem.sound().mute(myFastForwardFlag);
+        myOSystem.frameBuffer().showMessage(myFastForwardFlag ?
+            "Fast-forward on" : "Fast-forward off");
+      }
+      return;
+
     case Event::VolumeDecrease:
       if(state) myOSystem.sound().adjustVolume(-1);
       return;
@@ -1671,6 +1689,7 @@ void EventHandler::setDefaultKeymap(Event::Type event, EventMode mode)
       setDefaultKey( KBDK_F11,       Event::LoadState         );
       setDefaultKey( KBDK_F12,       Event::TakeSnapshot      );
       setDefaultKey( KBDK_BACKSPACE, Event::Fry               );
+      setDefaultKey( KBDK_INSERT,    Event::FastForward       );
       setDefaultKey( KBDK_PAUSE,     Event::PauseMode         );
       setDefaultKey( KBDK_TAB,       Event::MenuMode          );
       setDefaultKey( KBDK_BACKSLASH, Event::CmdMenuMode       );
@@ -1958,7 +1977,18 @@ void EventHandler::takeSnapshot(uInt32 number)
   VarList::push_back(comments, "Software", version.str());
   VarList::push_back(comments, "ROM Name", myOSystem.console().properties().get(Cartridge_Name));
   VarList::push_back(comments, "ROM MD5", myOSystem.console().properties().get(Cartridge_MD5));
-  VarList::push_back(comments, "TV Effects", myOSystem.frameBuffer().tiaSurface().effectsInfo());
+
+  // Continuous snapshots in 1x mode without TV effects are the TIA frame
+  // itself, which is written in the background, so it doesn't stall the
+  // emulation; all others are taken from the screen as usual
+  const TIASurface& tiaSurface = myOSystem.frameBuffer().tiaSurface();
+  if(number > 0 && myOSystem.settings().getBool("ss1x") &&
+     !tiaSurface.ntscEnabled() && !tiaSurface.phosphorEnabled())
+  {
+    myOSystem.capture().saveSnapshot(myOSystem.console().tia(), filename, comments);
+    return;
+  }
+  VarList::push_back(comments, "TV Effects", tiaSurface.effectsInfo());
 
   // Now create a PNG snapshot
   if(myOSystem.settings().getBool("ss1x"))
@@ -2133,7 +2163,7 @@ void EventHandler::setEventState(State state)
   {
     case S_EMULATE:
       myOverlay = nullptr;
-      myOSystem.sound().mute(false);
+      myOSystem.sound().mute(myFastForwardFlag);
       enableTextEvents(false);
       if(myOSystem.console().leftController().type() == Controller::CompuMate)
         myUseCtrlKeyFlag = false;
@@ -2159,6 +2189,7 @@ void EventHandler::setEventState(State state)
       myOverlay = &myOSystem.launcher();
       enableTextEvents(true);
       myEvent.clear();
+      myFastForwardFlag = false;
       break;
 
 #ifdef DEBUGGER_SUPPORT
@@ -2204,6 +2235,7 @@ EventHandler::ActionList EventHandler::ourEmulActionList[kEmulActionListSize] =
   { Event::LoadState,              "Load State",               "", false },
   { Event::TakeSnapshot,           "Snapshot",                 "", false },
   { Event::Fry,                    "Fry cartridge",            "", false },
+  { Event::FastForward,            "Toggle fast-forward mode", "", false },
   { Event::VolumeDecrease,         "Decrease volume",          "", false },
   { Event::VolumeIncrease,         "Increase volume",          "", false },
   { Event::PauseMode,              "Pause",                    "", false },
@@ -185,6 +185,7 @@ class EventHandler
     void handleConsoleStartupEvents();
 
     bool frying() const { return myFryingFlag; }
+    bool fastForward() const { return myFastForwardFlag; }
 
     StringList getActionList(EventMode mode) const;
     VariantList getComboList(EventMode mode) const;
@@ -487,7 +488,7 @@ class EventHandler
     enum {
       kComboSize          = 16,
       kEventsPerCombo     = 8,
-      kEmulActionListSize = 79 + kComboSize,
+      kEmulActionListSize = 80 + kComboSize,
       kMenuActionListSize = 14
     };
 
@@ -555,6 +556,9 @@ class EventHandler
     // Indicates whether or not we're in frying mode
     bool myFryingFlag;
 
+    // Indicates whether or not we're in fast-forward mode
+    bool myFastForwardFlag;
+
     // Indicates whether the key-combos tied to the Control key are
     // being used or not (since Ctrl by default is the fire button,
     // pressing it with a movement key could inadvertantly activate
@@ -205,6 +205,17 @@ class FBSurface
     */
     virtual void setDirty() { }
 
+    /**
+      This method should be called to indicate that only some rows of the
+      surface have been modified. The surface is redrawn at the next
+      interval, but only the given rows need to be transferred; with
+      zero rows, the surface is redrawn from its current contents.
+
+      @param y  The first modified row
+      @param h  The number of modified rows
+    */
+    virtual void setDirtyRows(uInt32 /* y */, uInt32 /* h */) { setDirty(); }
+
     //////////////////////////////////////////////////////////////////////////
     // Note:  The following methods are FBSurface-specific, and must be
     //        implemented in child classes.
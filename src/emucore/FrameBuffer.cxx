@@ -30,6 +30,11 @@
 #include "Menu.hxx"
 #include "OSystem.hxx"
 #include "Settings.hxx"
+#include "Sound.hxx"
+#include "StateManager.hxx"
+#include "CaptureManager.hxx"
+#include "System.hxx"
+#include "M6502.hxx"
 #include "TIA.hxx"
 
 #include "FBSurface.hxx"
@@ -43,8 +48,10 @@
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FrameBuffer::FrameBuffer(OSystem& osystem)
   : myOSystem(osystem),
+    myVsyncTime(0),
     myInitializedCount(0),
     myPausedCount(0),
+    myWindowVisible(true),
     myCurrentModeList(nullptr)
 {
   myMsg.surface = myStatsMsg.surface = nullptr;
@@ -225,7 +232,7 @@ FBInitStatus FrameBuffer::createDisplay(const string& title,
   // Create surfaces for TIA statistics and general messages
   myStatsMsg.color = kBtnTextColor;
   myStatsMsg.w = infoFont().getMaxCharWidth() * 24 + 2;
-  myStatsMsg.h = (infoFont().getFontHeight() + 2) * 2;
+  myStatsMsg.h = (infoFont().getFontHeight() + 2) * 4;
 
   if(!myStatsMsg.surface)
     myStatsMsg.surface = allocateSurface(myStatsMsg.w, myStatsMsg.h);
@@ -255,15 +262,80 @@ void FrameBuffer::update()
   // Take care of S_EMULATE mode here, otherwise let the GUI
   // figure out what to draw
 
-  invalidate();
+  // While the window is hidden or minimized, nothing is drawn; only the
+  // emulation itself (and therefore the sound) keeps running
+  bool visible = windowVisible();
+  if(visible != myWindowVisible)
+  {
+    myWindowVisible = visible;
+    if(visible)
+      myTIASurface->invalidate();
+  }
+  if(!visible && myOSystem.eventHandler().state() != EventHandler::S_EMULATE)
+    return;
+
+  if(myOSystem.eventHandler().state() != EventHandler::S_EMULATE)
+    invalidate();
   switch(myOSystem.eventHandler().state())
   {
     case EventHandler::S_EMULATE:
     {
-      // Run the console for one frame
+      // Run the console for one frame (several in fast-forward mode, where
+      // only the last one is rendered, unless all of them are recorded)
       // Note that the debugger can cause a breakpoint to occur, which changes
       // the EventHandler state 'behind our back' - we need to check for that
-      myOSystem.console().tia().update();
+      TIA& tia = myOSystem.console().tia();
+      Int32 frames = myOSystem.eventHandler().fastForward() ?
+          myOSystem.settings().getInt("ffratio") : 1;
+
+      // In pipelined mode, the last frame is converted on another thread
+      // in the meantime, and drawn below instead of the one emulated now
+      if(visible)
+        myTIASurface->startRender();
+
+      // In run-ahead mode, the frame itself isn't rendered; the one shown
+      // is emulated that many frames ahead of it, and then undone
+      // Breakpoints and traps can't be hit in frames which will be undone
+      uInt32 runAhead = myOSystem.state().runAheadFrames();
+  #ifdef DEBUGGER_SUPPORT
+      if(myOSystem.console().system().m6502().debuggerHooksActive())
+        runAhead = 0;
+  #endif
+
+      CaptureManager& capture = myOSystem.capture();
+      bool recording = capture.isRecording();
+
+      tia.setLogicOnly(!recording);
+      while(--frames > 0 && myOSystem.eventHandler().state() == EventHandler::S_EMULATE)
+      {
+        tia.update();
+        if(recording)
+          capture.addFrame(tia);
+        if(myOSystem.eventHandler().frying())
+          myOSystem.console().fry();
+      }
+      tia.setLogicOnly((runAhead > 0 || !visible) && !recording);
+
+      if(myOSystem.eventHandler().state() == EventHandler::S_EMULATE)
+      {
+        tia.update();
+        if(recording)
+          capture.addFrame(tia);
+      }
+      tia.setLogicOnly(false);
+
+      if(!visible)
+        return;
+
+      if(runAhead > 0 && myOSystem.eventHandler().state() == EventHandler::S_EMULATE)
+        myOSystem.state().runAhead(runAhead);
+
+      // When nothing on screen changed, the last frame is still being
+      // displayed, so there's no need to draw and present it again
+      if(myOSystem.eventHandler().state() == EventHandler::S_EMULATE &&
+         !myTIASurface->needsRender() && !myStatsMsg.enabled && !myMsg.enabled)
+        return;
+      invalidate();
   #ifdef DEBUGGER_SUPPORT
       if(myOSystem.eventHandler().state() != EventHandler::S_EMULATE) break;
   #endif
@@ -286,6 +358,32 @@ void FrameBuffer::update()
           msg, 1, 1, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
         myStatsMsg.surface->drawString(infoFont(),
           info.BankSwitch, 1, 15, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+
+        // Show the cost of running ahead in an extra line
+        uInt32 lines = 2;
+        if(myOSystem.state().runAheadFrames() > 0)
+        {
+          std::snprintf(msg, 30, "Run-ahead %u => +%.0ffps",
+                  myOSystem.state().runAheadFrames(),
+                  myOSystem.state().runAheadCost());
+          myStatsMsg.surface->drawString(infoFont(),
+            msg, 1, 1 + 14 * lines, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+          ++lines;
+        }
+
+        // And how well the sound is kept fed
+        Sound::Statistics stats;
+        if(myOSystem.sound().statistics(stats))
+        {
+          std::snprintf(msg, 30, "Sound %ums U:%u O:%u",
+                  stats.latency, stats.underruns, stats.overruns);
+          myStatsMsg.surface->drawString(infoFont(),
+            msg, 1, 1 + 14 * lines, myStatsMsg.w, myStatsMsg.color, kTextAlignLeft);
+          ++lines;
+        }
+        const uInt32 h = (infoFont().getFontHeight() + 2) * lines;
+        myStatsMsg.surface->setSrcSize(myStatsMsg.w, h);
+        myStatsMsg.surface->setDstSize(myStatsMsg.w, h);
         myStatsMsg.surface->setDirty();
         myStatsMsg.surface->setDstPos(myImageRect.x() + 1, myImageRect.y() + 1);
         myStatsMsg.surface->render();
@@ -511,6 +609,7 @@ void FrameBuffer::setPalette(const uInt32* raw_palette)
 
   // Let the TIA surface know about the new palette
   myTIASurface->setPalette(myPalette, raw_palette);
+  myOSystem.capture().setPalette(raw_palette);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -519,6 +618,10 @@ void FrameBuffer::stateChanged(EventHandler::State state)
   // Make sure any onscreen messages are removed
   myMsg.enabled = false;
   myMsg.counter = 0;
+
+  // Whatever was displayed in the previous state must be redrawn
+  if(myTIASurface)
+    myTIASurface->invalidate();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -175,6 +175,12 @@ class FrameBuffer
     */
     const GUI::Size& desktopSize() const { return myDesktopSize; }
 
+    /**
+      Returns the time (in usec) at which the last frame presented in sync
+      with the display refresh was shown, or 0 when presenting isn't vsync'ed.
+    */
+    uInt64 vsyncTime() const { return myVsyncTime; }
+
     /**
       Get the supported renderers for the video hardware.
 
@@ -273,6 +279,12 @@ class FrameBuffer
     */
     virtual bool fullScreen() const = 0;
 
+    /**
+      Answers if the window can currently be seen (ie, it isn't hidden
+      or minimized).
+    */
+    virtual bool windowVisible() const = 0;
+
     /**
       This method is called to retrieve the R/G/B data from the given pixel.
 
@@ -372,6 +384,9 @@ class FrameBuffer
     // Color palette for TIA and UI modes
     uInt32 myPalette[256+kNumColors];
 
+    // Time at which the last vsync'ed present returned (0 when not vsync'ed)
+    uInt64 myVsyncTime;
+
   private:
     /**
       Draw pending messages.
@@ -448,6 +463,9 @@ class FrameBuffer
     // Used to set intervals between messages while in pause mode
     Int32 myPausedCount;
 
+    // Whether the window could be seen during the last update
+    bool myWindowVisible;
+
     // Dimensions of the actual image, after zooming, and taking into account
     // any image 'centering'
     GUI::Rect myImageRect;
@@ -45,6 +45,13 @@
 #include "System.hxx"
 #include "M6502.hxx"
 
+// Compilers supporting labels as values ('&&label') get the direct-threaded
+// version of the instruction emulation (see M6502.m4); all others use the
+// switch statement
+#if defined(__GNUC__) && !defined(M6502_NO_THREADED_DISPATCH)
+  #define M6502_THREADED_DISPATCH
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 M6502::M6502(const Settings& settings)
   : myExecutionStatus(0),
@@ -111,6 +118,7 @@ void M6502::reset()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool hooks>
 inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
 {
   handleHalt();
@@ -128,7 +136,7 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
   myLastPeekAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
-  if(myReadTraps.isInitialized() && myReadTraps.isSet(address))
+  if(hooks && myReadTraps.isInitialized() && myReadTraps.isSet(address))
   {
     myLastPeekBaseAddress = myDebugger->getBaseAddress(myLastPeekAddress, true); // mirror handling
     int cond = evalCondTraps();
@@ -146,6 +154,7 @@ inline uInt8 M6502::peek(uInt16 address, uInt8 flags)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool hooks>
 inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
 {
   ////////////////////////////////////////////////
@@ -161,7 +170,7 @@ inline void M6502::poke(uInt16 address, uInt8 value, uInt8 flags)
   myLastPokeAddress = address;
 
 #ifdef DEBUGGER_SUPPORT
-  if(myWriteTraps.isInitialized() && myWriteTraps.isSet(address))
+  if(hooks && myWriteTraps.isInitialized() && myWriteTraps.isSet(address))
   {
     myLastPokeBaseAddress = myDebugger->getBaseAddress(myLastPokeAddress, false); // mirror handling
     int cond = evalCondTraps();
@@ -192,8 +201,47 @@ inline void M6502::handleHalt()
   }
 }
 
+#ifdef M6502_THREADED_DISPATCH
+  #ifdef DEBUGGER_SUPPORT
+    #define M6502_CHECK_DEBUGGER_HOOKS  if(hooks && checkDebuggerHooks()) return true;
+  #else
+    #define M6502_CHECK_DEBUGGER_HOOKS
+  #endif
+
+  // Fetch the instruction at the program counter and jump directly to its
+  // handler; this is done at the end of every handler, so each opcode has
+  // its own indirect branch
+  #define M6502_FETCH                                                   \
+    M6502_CHECK_DEBUGGER_HOOKS                                          \
+    operandAddress = intermediateAddress = 0;                           \
+    operand = 0;                                                        \
+    myLastPeekAddress = myLastPokeAddress = myDataAddressForPoke = 0;   \
+    IR = peek<hooks>(PC++, DISASM_CODE);                                \
+    goto *dispatchTable[IR];
+
+  // Finish the current instruction and continue with the next one, unless
+  // execution was stopped or the requested number of instructions is done
+  #define M6502_DISPATCH                                                \
+    if(--number == 0 || myExecutionStatus)                              \
+      goto dispatchDone;                                                \
+    M6502_FETCH
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6502::execute(uInt32 number)
+{
+#ifdef DEBUGGER_SUPPORT
+  // Only pay for the debugger checks when something can actually trigger
+  if(debuggerHooksActive())
+    return _execute<true>(number);
+#endif
+
+  return _execute<false>(number);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<bool hooks>
+bool M6502::_execute(uInt32 number)
 {
   // Clear all of the execution status bits except for the fatal error bit
   myExecutionStatus &= FatalErrorBit;
@@ -201,35 +249,34 @@ bool M6502::execute(uInt32 number)
   // Loop until execution is stopped or a fatal error occurs
   for(;;)
   {
-    for(; !myExecutionStatus && (number != 0); --number)
+#ifdef M6502_THREADED_DISPATCH
+    if(!myExecutionStatus && (number != 0))
     {
-#ifdef DEBUGGER_SUPPORT
-      if(myJustHitReadTrapFlag || myJustHitWriteTrapFlag)
-      {
-        myJustHitReadTrapFlag = myJustHitWriteTrapFlag = false;
-        if(myDebugger && myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address, myJustHitReadTrapFlag))
-        {
-          return true;
-        }
-      }
+      uInt16 operandAddress = 0, intermediateAddress = 0;
+      uInt8 operand = 0;
 
-      if(myBreakPoints.isInitialized() && myBreakPoints.isSet(PC))
-        if(myDebugger && myDebugger->start("BP: ", PC))
-          return true;
+      // The handlers are only ever entered through the dispatch table
+      goto dispatchFirst;
 
-      int cond = evalCondBreaks();
-      if(cond > -1)
-      {
-        string buf = "CBP: " + myCondBreakNames[cond];
-        if(myDebugger && myDebugger->start(buf))
-          return true;
-      }
+      // 6502 instruction emulation is generated by an M4 macro file
+      #include "M6502Threaded.ins"
 
-      cond = evalCondSaveStates();
-      if(cond > -1)
-      {
-        myDebugger->saveOldState("conditional savestate");
-      }
+    M6502_OP_ILLEGAL:
+      // Oops, illegal instruction executed so set fatal error flag
+      myExecutionStatus |= FatalErrorBit;
+      --number;
+      goto dispatchDone;
+
+    dispatchFirst:
+      M6502_FETCH
+    }
+  dispatchDone:
+#else
+    for(; !myExecutionStatus && (number != 0); --number)
+    {
+#ifdef DEBUGGER_SUPPORT
+      if(hooks && checkDebuggerHooks())
+        return true;
 #endif  // DEBUGGER_SUPPORT
 
       uInt16 operandAddress = 0, intermediateAddress = 0;
@@ -239,7 +286,7 @@ bool M6502::execute(uInt32 number)
       myLastPeekAddress = myLastPokeAddress = myDataAddressForPoke = 0;
 
       // Fetch instruction at the program counter
-      IR = peek(PC++, DISASM_CODE);  // This address represents a code section
+      IR = peek<hooks>(PC++, DISASM_CODE);  // This address represents a code section
 
       // Call code to execute the instruction
       switch(IR)
@@ -252,6 +299,7 @@ bool M6502::execute(uInt32 number)
           myExecutionStatus |= FatalErrorBit;
       }
     }
+#endif  // M6502_THREADED_DISPATCH
 
     // See if we need to handle an interrupt
     if((myExecutionStatus & MaskableInterruptBit) ||
@@ -421,6 +469,39 @@ bool M6502::load(Serializer& in)
 }
 
 #ifdef DEBUGGER_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool M6502::checkDebuggerHooks()
+{
+  if(myJustHitReadTrapFlag || myJustHitWriteTrapFlag)
+  {
+    myJustHitReadTrapFlag = myJustHitWriteTrapFlag = false;
+    if(myDebugger && myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address, myJustHitReadTrapFlag))
+    {
+      return true;
+    }
+  }
+
+  if(myBreakPoints.isInitialized() && myBreakPoints.isSet(PC))
+    if(myDebugger && myDebugger->start("BP: ", PC))
+      return true;
+
+  int cond = evalCondBreaks();
+  if(cond > -1)
+  {
+    string buf = "CBP: " + myCondBreakNames[cond];
+    if(myDebugger && myDebugger->start(buf))
+      return true;
+  }
+
+  cond = evalCondSaveStates();
+  if(cond > -1)
+  {
+    myDebugger->saveOldState("conditional savestate");
+  }
+
+  return false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6502::attach(Debugger& debugger)
 {
@@ -242,6 +242,18 @@ class M6502 : public Serializable
     bool delCondTrap(uInt32 brk);
     void clearCondTraps();
     const StringList& getCondTrapNames() const;
+
+    /**
+      Answer whether any breakpoint, trap or conditional expression is
+      registered, or a trap hit is still pending; only then does
+      execute() need to check for them.
+    */
+    bool debuggerHooksActive() const {
+      return myBreakPoints.isInitialized() ||
+             myReadTraps.isInitialized() || myWriteTraps.isInitialized() ||
+             !myCondBreaks.empty() || !myCondSaveStates.empty() ||
+             myJustHitReadTrapFlag || myJustHitWriteTrapFlag;
+    }
 #endif  // DEBUGGER_SUPPORT
 
   private:
@@ -257,6 +269,7 @@ class M6502 : public Serializable
 
       @return The byte at the specified address
     */
+    template<bool hooks>
     uInt8 peek(uInt16 address, uInt8 flags);
 
     /**
@@ -266,8 +279,20 @@ class M6502 : public Serializable
       @param address  The address where the value should be stored
       @param value    The value to be stored at the address
     */
+    template<bool hooks>
     void poke(uInt16 address, uInt8 value, uInt8 flags = 0);
 
+    /**
+      The actual instruction loop behind execute().  When 'hooks' is false,
+      the checks for breakpoints, traps and conditional expressions are
+      compiled out entirely.
+
+      @param number Indicates the number of instructions to execute
+      @return true iff execution stops normally
+    */
+    template<bool hooks>
+    bool _execute(uInt32 number);
+
     /**
       Get the 8-bit value of the Processor Status register.
 
@@ -414,6 +439,14 @@ class M6502 : public Serializable
       return -1; // no trapif hit
     }
 
+    /**
+      Check for trap hits, breakpoints, conditional breakpoints and
+      conditional save states before executing the instruction at PC.
+
+      @return true iff the debugger was entered and execution must stop
+    */
+    bool checkDebuggerHooks();
+
     /// Pointer to the debugger for this processor or the null pointer
     Debugger* myDebugger;
 
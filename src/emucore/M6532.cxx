@@ -72,6 +72,7 @@ void M6532::reset()
   myWrappedThisCycle = false;
 
   mySetTimerCycle = myLastCycle = 0;
+  updateTimerDeadline();
 
   // Zero the I/O registers
   myDDRA = myDDRB = myOutA = myOutB = 0x00;
@@ -155,6 +156,18 @@ void M6532::updateEmulation()
   myLastCycle = mySystem->cycles();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void M6532::updateTimerDeadline()
+{
+  // Once wrapped, the timer just keeps counting down; there is nothing
+  // left to do until it is written again
+  if(myTimerWrapped)
+    mySystem->clearDeadline(*this);
+  else
+    mySystem->setDeadline(*this,
+        myLastCycle + uInt64(myTimer + 1) * myDivider - mySubTimer);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void M6532::install(System& system)
 {
@@ -327,6 +340,7 @@ void M6532::setTimerRegister(uInt8 value, uInt8 interval)
   myInterruptFlag &= ~TimerBit;
 
   mySetTimerCycle = mySystem->cycles();
+  updateTimerDeadline();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -424,6 +438,8 @@ bool M6532::load(Serializer& in)
     myInterruptFlag = in.getByte();
     myEdgeDetectPositive = in.getBool();
     in.getByteArray(myOutTimer, 4);
+
+    updateTimerDeadline();
   }
   catch(...)
   {
@@ -24,6 +24,7 @@ class System;
 class Settings;
 
 #include "bspf.hxx"
+#include "DeadlineListener.hxx"
 #include "Device.hxx"
 
 /**
@@ -36,7 +37,7 @@ class Settings;
 
   @author  Bradford W. Mott and Stephen Anthony
 */
-class M6532 : public Device
+class M6532 : public Device, public DeadlineListener
 {
   public:
     /**
@@ -125,6 +126,12 @@ class M6532 : public Device
     */
     bool poke(uInt16 address, uInt8 value) override;
 
+    /**
+      Called by the system when the timer wraps, to raise the timer
+      interrupt flag even if the RIOT isn't accessed at that time.
+    */
+    void deadlineReached() override { updateEmulation(); }
+
   private:
 
     void setTimerRegister(uInt8 data, uInt8 interval);
@@ -132,6 +139,9 @@ class M6532 : public Device
 
     void updateEmulation();
 
+    // Register the cycle at which the timer will wrap with the system
+    void updateTimerDeadline();
+
     // The following are used by the debugger to read INTIM/TIMINT
     // We need separate methods to do this, so the state of the system
     // isn't changed
@@ -16,6 +16,9 @@
 //============================================================================
 
 #include <cassert>
+#include <cmath>
+#include <chrono>
+#include <thread>
 
 #include <ctime>
 #ifdef HAVE_GETTIMEOFDAY
@@ -53,6 +56,7 @@
 #include "Random.hxx"
 #include "SerialPort.hxx"
 #include "StateManager.hxx"
+#include "CaptureManager.hxx"
 #include "Version.hxx"
 
 #include "OSystem.hxx"
@@ -96,6 +100,9 @@ OSystem::OSystem()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 OSystem::~OSystem()
 {
+  // The encoder thread must be finished before anything else goes away
+  if(myCaptureManager)
+    myCaptureManager->stopRecording();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -141,6 +148,7 @@ bool OSystem::create()
   myCommandMenu = make_unique<CommandMenu>(*this);
   myLauncher = make_unique<Launcher>(*this);
   myStateManager = make_unique<StateManager>(*this);
+  myCaptureManager = make_unique<CaptureManager>(*this);
 
   // Create the sound object; the sound subsystem isn't actually
   // opened until needed, so this is non-blocking (on those systems
@@ -236,6 +244,12 @@ void OSystem::setFramerate(float framerate)
 {
   if(framerate > 0.0)
   {
+    // Deadlines at the new rate continue from the current one
+    if(framerate != myDisplayFrameRate)
+    {
+      myTimingInfo.anchor = myTimingInfo.virt;
+      myTimingInfo.pacedFrames = 0;
+    }
     myDisplayFrameRate = framerate;
     myTimePerFrame = uInt32(1000000.0 / myDisplayFrameRate);
   }
@@ -358,6 +372,9 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
     // Update the timing info for a new console run
     resetLoopTiming();
 
+    if(mySettings->getBool("capture"))
+      myCaptureManager->startRecording();
+
     myFrameBuffer->setCursorState();
 
     // Also check if certain virtual buttons should be held down
@@ -521,6 +538,7 @@ void OSystem::closeConsole()
     // If a previous console existed, save cheats before creating a new one
     myCheatManager->saveCheats(myConsole->properties().get(Cartridge_MD5));
   #endif
+    myCaptureManager->stopRecording();
     myConsole.reset();
   }
 }
@@ -575,6 +593,131 @@ void OSystem::resetLoopTiming()
   myTimingInfo.current = 0;
   myTimingInfo.totalTime = 0;
   myTimingInfo.totalFrames = 0;
+  myTimingInfo.lateFrames = myTimingInfo.earlyFrames = 0;
+  myTimingInfo.wakeupLatency = 1000;
+  myTimingInfo.vsyncTime = myTimingInfo.vblank = 0;
+  myTimingInfo.refreshPeriod = 0;
+  anchorLoopTiming(myTimingInfo.start);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::anchorLoopTiming(uInt64 time)
+{
+  myTimingInfo.anchor = myTimingInfo.virt = time;
+  myTimingInfo.pacedFrames = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OSystem::syncToDisplay()
+{
+  TimingInfo& t = myTimingInfo;
+  const double period = 1000000.0 / myDisplayFrameRate;
+  const uInt64 vsync = myFrameBuffer->vsyncTime();
+
+  if(vsync == 0)
+  {
+    t.vsyncTime = 0;
+    t.refreshPeriod = 0;
+    return false;
+  }
+
+  if(vsync != t.vsyncTime)
+  {
+    // Presents may be skipped (or miss a refresh), so the time between
+    // them is split into the number of refreshes closest to a frame each
+    if(t.vsyncTime > 0 && vsync > t.vsyncTime)
+    {
+      const double interval = double(vsync - t.vsyncTime),
+                   refreshes = std::round(interval / period);
+      if(refreshes >= 1 && refreshes <= 4 &&
+         std::abs(interval / refreshes - period) < period / 4)
+      {
+        const double sample = interval / refreshes;
+        t.refreshPeriod = t.refreshPeriod > 0 ?
+          t.refreshPeriod + (sample - t.refreshPeriod) / 32 : sample;
+      }
+    }
+    t.vsyncTime = t.vblank = vsync;
+  }
+  else  // Nothing was presented, but the frame would have been shown now
+    t.vblank += uInt64(t.refreshPeriod > 0 ? t.refreshPeriod : period);
+
+  // A display refreshing at (almost) the framerate paces the frames, one
+  // per refresh, instead of slowly drifting against the framerate, which
+  // every so often shows a frame twice or never.  The sound adapts its
+  // rate by up to 0.5%, which bounds the difference in rates.
+  return t.refreshPeriod > 0 && std::abs(t.refreshPeriod - period) < period * 0.005;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OSystem::waitForNextFrame(bool sleep, bool spin)
+{
+  // Spinning starts this long before the deadline, in case the OS wakes up
+  // later than it did so far; a frame is only counted as late/early when
+  // it misses the deadline by more than the tolerance
+  constexpr uInt64 spinMargin = 200, tolerance = 500;
+
+  TimingInfo& t = myTimingInfo;
+
+  if(syncToDisplay())
+  {
+    // Start each frame half a refresh before the one it is shown on, which
+    // leaves the most room for it both to run longer and to start late
+    t.virt = t.vblank + uInt64(t.refreshPeriod / 2);
+    anchorLoopTiming(t.virt);
+  }
+  else
+  {
+    // Deadlines are counted from an anchor rather than added up, so that
+    // the rounding of the time per frame doesn't make the pace drift
+    t.virt = t.anchor + uInt64(++t.pacedFrames * 1000000.0 / myDisplayFrameRate);
+  }
+
+  // Timestamps may periodically go out of sync, particularly on systems
+  // that can have 'negative time' (ie, when the time seems to go backwards),
+  // and frames may take much longer than usual (ie, when a vsync'ed display
+  // doesn't match the framerate, or when loading); instead of waiting for a
+  // long time, or rushing through frames to catch up, start over from now
+  if(t.virt > t.current + (myTimePerFrame << 1) ||
+     t.current > t.virt + myTimePerFrame)
+  {
+    if(t.current > t.virt)
+      ++t.lateFrames;
+    anchorLoopTiming(t.current);
+    t.vblank = t.current - uInt64(t.refreshPeriod / 2);
+    return;
+  }
+
+  if(sleep && t.current + t.wakeupLatency + spinMargin < t.virt)
+  {
+    const uInt64 wakeup = t.virt - t.wakeupLatency - (spin ? spinMargin : 0);
+    std::this_thread::sleep_for(std::chrono::microseconds(wakeup - t.current));
+
+    // Before spinning, follow increases in wakeup latency right away and
+    // decreases slowly, to rarely oversleep; sleeping alone follows the
+    // average latency, to wake up on the deadline
+    const uInt64 now = getTicks(), latency = now > wakeup ? now - wakeup : 0;
+    if(spin && latency > t.wakeupLatency)
+      t.wakeupLatency = latency;
+    else if(latency < t.wakeupLatency)
+      t.wakeupLatency -= (t.wakeupLatency - latency) / 16;
+    else
+      t.wakeupLatency += (latency - t.wakeupLatency) / 16;
+    t.wakeupLatency = std::min(t.wakeupLatency, uInt64(myTimePerFrame >> 1));
+  }
+
+  if(spin)
+  {
+    // Yielding lets other processes run, while still catching the deadline
+    while(getTicks() < t.virt)
+      std::this_thread::yield();
+  }
+
+  const uInt64 now = getTicks();
+  if(now > t.virt + tolerance)
+    ++t.lateFrames;
+  else if(now + tolerance < t.virt)
+    ++t.earlyFrames;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -612,53 +755,40 @@ uInt64 OSystem::getTicks() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void OSystem::mainLoop()
 {
-  if(mySettings->getString("timing") == "sleep")
-  {
-    // Sleep-based wait: good for CPU, bad for graphical sync
-    for(;;)
-    {
-      myTimingInfo.start = getTicks();
-      myEventHandler->poll(myTimingInfo.start);
-      if(myQuitLoop) break;  // Exit if the user wants to quit
-      myFrameBuffer->update();
-      myTimingInfo.current = getTicks();
-      myTimingInfo.virt += myTimePerFrame;
-
-      // Timestamps may periodically go out of sync, particularly on systems
-      // that can have 'negative time' (ie, when the time seems to go backwards)
-      // This normally results in having a very large delay time, so we check
-      // for that and reset the timers when appropriate
-      if((myTimingInfo.virt - myTimingInfo.current) > (myTimePerFrame << 1))
-      {
-        myTimingInfo.start = myTimingInfo.current = myTimingInfo.virt = getTicks();
-      }
+  // Sleep: good for CPU, bad for graphical sync
+  // Busy-wait: bad for CPU, good for graphical sync
+  // Hybrid: sleep for most of the wait, and busy-wait for the rest
+  const string& timing = mySettings->getString("timing");
+  const bool sleep = timing != "busy", spin = timing != "sleep";
 
-      if(myTimingInfo.current < myTimingInfo.virt)
-        SDL_Delay(uInt32(myTimingInfo.virt - myTimingInfo.current) / 1000);
-
-      myTimingInfo.totalTime += (getTicks() - myTimingInfo.start);
-      myTimingInfo.totalFrames++;
-    }
-  }
-  else
+  for(;;)
   {
-    // Busy-wait: bad for CPU, good for graphical sync
-    for(;;)
-    {
-      myTimingInfo.start = getTicks();
-      myEventHandler->poll(myTimingInfo.start);
-      if(myQuitLoop) break;  // Exit if the user wants to quit
-      myFrameBuffer->update();
-      myTimingInfo.virt += myTimePerFrame;
-
-      while(getTicks() < myTimingInfo.virt)
-        ;  // busy-wait
-
-      myTimingInfo.totalTime += (getTicks() - myTimingInfo.start);
-      myTimingInfo.totalFrames++;
-    }
+    myTimingInfo.start = getTicks();
+    myEventHandler->poll(myTimingInfo.start);
+    if(myQuitLoop) break;  // Exit if the user wants to quit
+    myFrameBuffer->update();
+    myTimingInfo.current = getTicks();
+
+    // Fast-forward runs as fast as possible
+    if(myEventHandler->fastForward())
+      anchorLoopTiming(myTimingInfo.current);
+    else
+      waitForNextFrame(sleep, spin);
+
+    myTimingInfo.totalTime += (getTicks() - myTimingInfo.start);
+    myTimingInfo.totalFrames++;
   }
 
+  ostringstream buf;
+  buf << "Frame pacing: " << myTimingInfo.totalFrames << " frames, "
+      << myTimingInfo.lateFrames << " late, "
+      << myTimingInfo.earlyFrames << " early, wakeup latency "
+      << myTimingInfo.wakeupLatency << " usec" << endl;
+  logMessage(buf.str(), 2);
+
+  // Stop the sound, which also logs its statistics
+  mySound->close();
+
   // Cleanup time
 #ifdef CHEATCODE_SUPPORT
   if(myConsole)
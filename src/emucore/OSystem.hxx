@@ -35,6 +35,7 @@ class SerialPort;
 class Settings;
 class Sound;
 class StateManager;
+class CaptureManager;
 class VideoDialog;
 
 #include "EventHandler.hxx"
@@ -48,6 +49,23 @@ struct TimingInfo {
   uInt64 virt;
   uInt64 totalTime;
   uInt64 totalFrames;
+
+  // Frame deadlines are counted from 'anchor'
+  uInt64 anchor;
+  uInt64 pacedFrames;
+
+  // Frames which were shown after/before their deadline
+  uInt64 lateFrames;
+  uInt64 earlyFrames;
+
+  // How much later than requested the OS wakes up from sleeping
+  uInt64 wakeupLatency;
+
+  // Last vsync'ed present seen, the refresh showing the current frame,
+  // and the measured time between refreshes (0 while unknown)
+  uInt64 vsyncTime;
+  uInt64 vblank;
+  double refreshPeriod;
 };
 
 /**
@@ -159,6 +177,13 @@ class OSystem
     */
     StateManager& state() const { return *myStateManager; }
 
+    /**
+      Get the capture manager of the system.
+
+      @return The capturemanager object
+    */
+    CaptureManager& capture() const { return *myCaptureManager; }
+
     /**
       Get the PNG handler of the system.
 
@@ -474,6 +499,9 @@ class OSystem
     // Pointer to the StateManager object
     unique_ptr<StateManager> myStateManager;
 
+    // Pointer to the CaptureManager object
+    unique_ptr<CaptureManager> myCaptureManager;
+
     // PNG object responsible for loading/saving PNG images
     unique_ptr<PNGLibrary> myPNGLib;
 
@@ -571,6 +599,30 @@ class OSystem
     */
     void resetLoopTiming();
 
+    /**
+      Restart counting frame deadlines from the given time.
+    */
+    void anchorLoopTiming(uInt64 time);
+
+    /**
+      Measure the refresh rate of a vsync'ed display, and determine whether
+      it is close enough to the framerate for the display to pace frames.
+
+      @return  Whether the next deadline follows the display refresh
+    */
+    bool syncToDisplay();
+
+    /**
+      Wait until the deadline of the next frame.  Sleeping is used for the
+      most part of the wait, as far as it can be done without oversleeping,
+      and spinning for the rest.  Sleeping alone aims at the deadline itself,
+      so that it wakes up as often early as late.
+
+      @param sleep  Whether to sleep
+      @param spin   Whether to spin
+    */
+    void waitForNextFrame(bool sleep, bool spin);
+
     /**
       Validate the directory name, and create it if necessary.
       Also, update the settings with the new name.  For now, validation
@@ -38,7 +38,10 @@ Settings::Settings(OSystem& osystem)
   setInternal("fullscreen", "false");
   setInternal("center", "false");
   setInternal("palette", "standard");
-  setInternal("timing", "sleep");
+  setInternal("timing", "hybrid");
+  setInternal("pipeline", "latency");
+  setInternal("ffratio", "10");
+  setInternal("runahead", "0");
   setInternal("uimessages", "true");
 
   // TIA specific options
@@ -70,6 +73,7 @@ Settings::Settings(OSystem& osystem)
   // Sound options
   setInternal("sound", "true");
   setInternal("fragsize", "512");
+  setInternal("audiolatency", "0");
   setInternal("freq", "31400");
   setInternal("volume", "100");
 
@@ -95,6 +99,7 @@ Settings::Settings(OSystem& osystem)
   setInternal("sssingle", "false");
   setInternal("ss1x", "false");
   setInternal("ssinterval", "2");
+  setInternal("capture", "false");
 
   // Config files and paths
   setInternal("romdir", "");
@@ -130,6 +135,8 @@ Settings::Settings(OSystem& osystem)
   setInternal("avoxport", "");
   setInternal("fastscbios", "true");
   setInternal("threads", "false");
+  setInternal("threadcount", "0");
+  setInternal("threadaffinity", "false");
   setExternal("romloadcount", "0");
   setExternal("maxres", "");
 
@@ -142,6 +149,7 @@ Settings::Settings(OSystem& osystem)
   setInternal("dis.gfxformat", "2");
   setInternal("dis.showaddr", "true");
   setInternal("dis.relocate", "false");
+  setInternal("dis.trackaccess", "false");
 #endif
 
   // player settings
@@ -296,7 +304,23 @@ void Settings::validate()
   int i;
 
   s = getString("timing");
-  if(s != "sleep" && s != "busy")  setInternal("timing", "sleep");
+  if(s != "sleep" && s != "busy" && s != "hybrid")
+    setInternal("timing", "hybrid");
+
+  s = getString("pipeline");
+  if(s != "latency" && s != "throughput")  setInternal("pipeline", "latency");
+
+  i = getInt("ffratio");
+  if(i < 1)         setInternal("ffratio", "1");
+  else if(i > 100)  setInternal("ffratio", "100");
+
+  i = getInt("runahead");
+  if(i < 0)         setInternal("runahead", "0");
+  else if(i > 10)   setInternal("runahead", "10");
+
+  i = getInt("threadcount");
+  if(i < 0)         setInternal("threadcount", "0");
+  else if(i > 64)   setInternal("threadcount", "64");
 
   i = getInt("tia.aspectn");
   if(i < 80 || i > 120)  setInternal("tia.aspectn", "90");
@@ -360,6 +384,8 @@ void Settings::validate()
   i = getInt("freq");
   if(!(i == 11025 || i == 22050 || i == 31400 || i == 44100 || i == 48000))
     setInternal("freq", "31400");
+  i = getInt("audiolatency");
+  if(i < 0 || i > 500)  setInternal("audiolatency", "0");
 #endif
 
   i = getInt("joydeadzone");
@@ -435,12 +461,18 @@ void Settings::usage() const
     << "                 z26|\n"
     << "                 user>\n"
     << "  -framerate    <number>       Display the given number of frames per second (0 to auto-calculate)\n"
-    << "  -timing       <sleep|busy>   Use the given type of wait between frames\n"
+    << "  -timing       <sleep|busy|   Use the given type of wait between frames\n"
+    << "                 hybrid>\n"
+    << "  -pipeline     <latency|      Draw each frame right away, or convert it while\n"
+    << "                 throughput>    the next one is emulated (one frame behind)\n"
+    << "  -ffratio      <1-100>        Emulate this many frames per displayed frame in fast-forward mode\n"
+    << "  -runahead     <0-10>         Show each frame as it will look this many frames ahead\n"
     << "  -uimessages   <1|0>          Show onscreen UI messages for different events\n"
     << endl
   #ifdef SOUND_SUPPORT
     << "  -sound        <1|0>          Enable sound generation\n"
     << "  -fragsize     <number>       The size of sound fragments (must be a power of two)\n"
+    << "  -audiolatency <0-500>        Adapt the fragment size to this latency (msec, 0 = fixed)\n"
     << "  -freq         <number>       Set sound sample output frequency (11025|22050|31400|44100|48000)\n"
     << "  -volume       <number>       Set the volume (0 - 100)\n"
     << endl
@@ -486,12 +518,15 @@ void Settings::usage() const
     << "  -autoslot     <1|0>          Automatically switch to next save slot when state saving\n"
     << "  -fastscbios   <1|0>          Disable Supercharger BIOS progress loading bars\n"
     << "  -threads      <1|0>          Whether to using multi-threading during emulation\n"
+    << "  -threadcount  <number>       Number of rendering threads (0 = one per core)\n"
+    << "  -threadaffinity <1|0>        Pin each rendering thread to its own core\n"
     << "  -snapsavedir  <path>         The directory to save snapshot files to\n"
     << "  -snaploaddir  <path>         The directory to load snapshot files from\n"
     << "  -snapname     <int|rom>      Name snapshots according to internal database or ROM\n"
     << "  -sssingle     <1|0>          Generate single snapshot instead of many\n"
     << "  -ss1x         <1|0>          Generate TIA snapshot in 1x mode (ignore scaling/effects)\n"
     << "  -ssinterval   <number        Number of seconds between snapshots in continuous snapshot mode\n"
+    << "  -capture      <1|0>          Record video and sound of each ROM into the snapshot directory\n"
     << endl
     << "  -rominfo      <rom>          Display detailed information for the given ROM\n"
     << "  -listrominfo                 Display contents of stella.pro, one line per ROM entry\n"
@@ -528,6 +563,8 @@ void Settings::usage() const
     << "   -dis.gfxformat <2|16>       Set base to use for displaying GFX sections in disassembler\n"
     << "   -dis.showaddr  <1|0>        Show opcode addresses in disassembler\n"
     << "   -dis.relocate  <1|0>        Relocate calls out of address range in disassembler\n"
+    << "   -dis.trackaccess <1|0>      Track code/data accesses for disassembler before\n"
+    << "                               the debugger is first entered\n"
     << endl
     << "   -dbg.res       <WxH>          The resolution to use in debugger mode\n"
     << "   -dbg.fontsize  <small|medium| Font size to use in debugger window\n"
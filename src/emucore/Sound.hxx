@@ -31,6 +31,17 @@ class OSystem;
 */
 class Sound : public Serializable
 {
+  public:
+    // How well the sound device is being kept fed
+    struct Statistics {
+      uInt32 fragmentSize;   // samples per fragment of the device
+      uInt32 latency;        // msec of sound waiting to be played
+      uInt32 targetLatency;  // msec of sound which should be waiting
+      uInt32 underruns;      // times there was no sound to play
+      uInt32 overruns;       // times there was too much sound to play
+      uInt32 droppedSamples; // samples which were never played
+    };
+
   public:
     /**
       Create a new sound object.  The init method must be invoked before
@@ -95,6 +106,15 @@ class Sound : public Serializable
     */
     virtual void set(uInt16 addr, uInt8 value, uInt64 cycle) = 0;
 
+    /**
+      Generates the sound up to the given system cycle.  This is called at
+      the end of each frame, so sound is produced even when the registers
+      don't change.
+
+      @param cycle The current system cycle
+    */
+    virtual void update(uInt64 cycle) = 0;
+
     /**
       Sets the volume of the sound device to the specified level.  The
       volume is given as a percentage from 0 to 100.  Values outside
@@ -112,6 +132,14 @@ class Sound : public Serializable
     */
     virtual void adjustVolume(Int8 direction) = 0;
 
+    /**
+      Gets the statistics of the sound device, since sound was opened.
+
+      @param stats The statistics
+      @return  False if sound isn't being played, so there are none
+    */
+    virtual bool statistics(Statistics& stats) const = 0;
+
   protected:
     // The OSystem for this sound object
     OSystem& myOSystem;
@@ -34,8 +34,10 @@ System::System(const OSystem& osystem, M6502& m6502, M6532& m6532,
     myTIA(mTIA),
     myCart(mCart),
     myCycles(0),
+    myNextDeadline(~0ull),
     myDataBusState(0),
     myDataBusLocked(false),
+    myAccessTracking(false),
     mySystemInAutodetect(false)
 {
   // Re-initialize random generator
@@ -71,6 +73,8 @@ void System::reset(bool autodetect)
 
   // Reset all devices
   myCycles = 0;     // Must be done first (the reset() methods may use its value)
+  myDeadlines.clear();
+  myNextDeadline = ~0ull;
   myM6532.reset();
   myTIA.reset();
   myCart.reset();
@@ -80,6 +84,58 @@ void System::reset(bool autodetect)
   clearDirtyPages();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::setDeadline(DeadlineListener& listener, uInt64 cycle)
+{
+  auto it = std::find_if(myDeadlines.begin(), myDeadlines.end(),
+      [&listener](const Deadline& d) { return d.listener == &listener; });
+
+  if(it != myDeadlines.end())
+    it->cycle = cycle;
+  else
+    myDeadlines.push_back({&listener, cycle});
+
+  updateNextDeadline();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::clearDeadline(DeadlineListener& listener)
+{
+  myDeadlines.erase(std::remove_if(myDeadlines.begin(), myDeadlines.end(),
+      [&listener](const Deadline& d) { return d.listener == &listener; }),
+      myDeadlines.end());
+
+  updateNextDeadline();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::processDeadlines()
+{
+  // Listeners may register new deadlines while being notified, so look for
+  // the next expired one from scratch each time
+  for(;;)
+  {
+    auto it = std::find_if(myDeadlines.begin(), myDeadlines.end(),
+        [this](const Deadline& d) { return d.cycle <= myCycles; });
+    if(it == myDeadlines.end())
+      break;
+
+    DeadlineListener* listener = it->listener;
+    myDeadlines.erase(it);
+    listener->deadlineReached();
+  }
+
+  updateNextDeadline();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void System::updateNextDeadline()
+{
+  myNextDeadline = ~0ull;
+  for(const auto& d: myDeadlines)
+    myNextDeadline = std::min(myNextDeadline, d.cycle);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void System::consoleChanged(ConsoleTiming timing)
 {
@@ -114,11 +170,14 @@ uInt8 System::peek(uInt16 addr, uInt8 flags)
   const PageAccess& access = getPageAccess(addr);
 
 #ifdef DEBUGGER_SUPPORT
-  // Set access type
-  if(access.codeAccessBase)
-    *(access.codeAccessBase + (addr & PAGE_MASK)) |= flags;
-  else
-    access.device->setAccessFlags(addr, flags);
+  // Set access type (only when someone is interested in it)
+  if(myAccessTracking)
+  {
+    if(access.codeAccessBase)
+      *(access.codeAccessBase + (addr & PAGE_MASK)) |= flags;
+    else
+      access.device->setAccessFlags(addr, flags);
+  }
 #endif
 
   // See if this page uses direct accessing or not
@@ -143,11 +202,14 @@ void System::poke(uInt16 addr, uInt8 value, uInt8 flags)
   const PageAccess& access = myPageAccessTable[page];
 
 #ifdef DEBUGGER_SUPPORT
-  // Set access type
-  if (access.codeAccessBase)
-    *(access.codeAccessBase + (addr & PAGE_MASK)) |= flags;
-  else
-    access.device->setAccessFlags(addr, flags);
+  // Set access type (only when someone is interested in it)
+  if(myAccessTracking)
+  {
+    if(access.codeAccessBase)
+      *(access.codeAccessBase + (addr & PAGE_MASK)) |= flags;
+    else
+      access.device->setAccessFlags(addr, flags);
+  }
 #endif
 
   // See if this page uses direct accessing or not
@@ -188,6 +250,9 @@ uInt8 System::getAccessFlags(uInt16 addr) const
 void System::setAccessFlags(uInt16 addr, uInt8 flags)
 {
 #ifdef DEBUGGER_SUPPORT
+  if(!myAccessTracking)
+    return;
+
   const PageAccess& access = getPageAccess(addr);
 
   if(access.codeAccessBase)
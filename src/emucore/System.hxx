@@ -25,6 +25,7 @@ class TIA;
 class NullDevice;
 
 #include "bspf.hxx"
+#include "DeadlineListener.hxx"
 #include "Device.hxx"
 #include "NullDev.hxx"
 #include "Random.hxx"
@@ -137,11 +138,34 @@ class System : public Serializable
     uInt64 cycles() const { return myCycles; }
 
     /**
-      Increment the system cycles by the specified number of cycles.
+      Increment the system cycles by the specified number of cycles, and
+      notify the listeners whose deadline has been reached.
 
       @param amount The amount to add to the system cycles counter
     */
-    void incrementCycles(uInt32 amount) { myCycles += amount; }
+    void incrementCycles(uInt32 amount)
+    {
+      myCycles += amount;
+      if(myCycles >= myNextDeadline)
+        processDeadlines();
+    }
+
+    /**
+      Notify the given listener once the system cycles reach the given
+      value.  Each listener has at most one deadline; setting a new one
+      replaces the previous one.  All deadlines are dropped on reset.
+
+      @param listener The object to notify
+      @param cycle    The system cycle at which to notify it
+    */
+    void setDeadline(DeadlineListener& listener, uInt64 cycle);
+
+    /**
+      Remove the deadline of the given listener, if any.
+
+      @param listener The object which no longer needs to be notified
+    */
+    void clearDeadline(DeadlineListener& listener);
 
     /**
       Informs all attached devices that the console type has changed.
@@ -232,6 +256,15 @@ class System : public Serializable
     uInt8 getAccessFlags(uInt16 address) const;
     void setAccessFlags(uInt16 address, uInt8 flags);
 
+    /**
+      Enable/disable tracking of the disassembly type flags by peek()
+      and poke().  Tracking is off by default, since only the debugger
+      uses this information; it is switched on the first time the
+      debugger is entered (or at startup with 'dis.trackaccess').
+    */
+    void setAccessTracking(bool enable) { myAccessTracking = enable; }
+    bool accessTracking() const { return myAccessTracking; }
+
   public:
     /**
       Describes how a page can be accessed
@@ -310,6 +343,18 @@ class System : public Serializable
       myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT] = access;
     }
 
+    /**
+      Set the page accessing methods for a block of consecutive pages.
+
+      @param addr   The address of the first page
+      @param access The accessing methods to be used, one entry per page
+      @param pages  The number of pages
+    */
+    void setPageAccess(uInt16 addr, const PageAccess* access, uInt16 pages) {
+      std::copy(access, access + pages,
+                &myPageAccessTable[(addr & ADDRESS_MASK) >> PAGE_SHIFT]);
+    }
+
     /**
       Get the page accessing method for the specified address.
 
@@ -376,6 +421,17 @@ class System : public Serializable
     */
     string name() const override { return "System"; }
 
+  private:
+    /**
+      Notify and remove all listeners whose deadline has been reached.
+    */
+    void processDeadlines();
+
+    /**
+      Recalculate myNextDeadline from the registered deadlines.
+    */
+    void updateNextDeadline();
+
   private:
     const OSystem& myOSystem;
 
@@ -394,6 +450,16 @@ class System : public Serializable
     // Number of system cycles executed since last reset
     uInt64 myCycles;
 
+    // Listeners waiting for the system cycles to reach a given value, and
+    // the earliest of those values (or the maximum if there are none)
+    struct Deadline
+    {
+      DeadlineListener* listener;
+      uInt64 cycle;
+    };
+    vector<Deadline> myDeadlines;
+    uInt64 myNextDeadline;
+
     // Null device to use for page which are not installed
     NullDevice myNullDevice;
 
@@ -411,6 +477,10 @@ class System : public Serializable
     // debugger is active.
     bool myDataBusLocked;
 
+    // Whether peek() and poke() record the disassembly type flags
+    // (see setAccessTracking())
+    bool myAccessTracking;
+
     // Whether autodetection is currently running (ie, the emulation
     // core is attempting to autodetect display settings, cart modes, etc)
     // Some parts of the codebase need to act differently in such a case
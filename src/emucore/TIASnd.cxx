@@ -158,6 +158,63 @@ void TIASound::volume(uInt32 percent)
     myVolumePercentage = percent;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+inline uInt32 TIASound::output(Int16*& buffer, uInt32& samples, uInt32 ticks,
+                               Int16 v0, Int16 v1)
+{
+  // Every tick adds the output frequency to the counter, and a sample is
+  // output for each 31400 in it; find how many samples the given ticks
+  // output, or how many ticks it takes to fill the buffer
+  uInt32 count;
+  if(myOutputFrequency == 31400 && myOutputCounter < 31400)
+  {
+    // The usual case: one sample per tick
+    count = ticks = std::min(ticks, samples);
+  }
+  else
+  {
+    Int64 counter = myOutputCounter + Int64(ticks) * myOutputFrequency;
+    if(counter < Int64(samples) * 31400)
+    {
+      count = uInt32(counter / 31400);
+      myOutputCounter = Int32(counter - Int64(count) * 31400);
+    }
+    else
+    {
+      Int64 needed = Int64(samples) * 31400 - myOutputCounter;
+      ticks = needed > 0 ?
+          uInt32((needed + myOutputFrequency - 1) / myOutputFrequency) : 1;
+      count = samples;
+      myOutputCounter = Int32(myOutputCounter +
+          Int64(ticks) * myOutputFrequency - Int64(count) * 31400);
+    }
+  }
+  samples -= count;
+
+  switch(myChannelMode)
+  {
+    case Hardware2Mono:  // mono sampling with 2 hardware channels
+      std::fill_n(buffer, count * 2, Int16(v0 + v1));
+      buffer += count * 2;
+      break;
+
+    case Hardware2Stereo:  // stereo sampling with 2 hardware channels
+      for(uInt32 i = 0; i < count; ++i)
+      {
+        *(buffer++) = v0;
+        *(buffer++) = v1;
+      }
+      break;
+
+    case Hardware1:  // mono/stereo sampling with only 1 hardware channel
+      std::fill_n(buffer, count, Int16(v0 + v1));
+      buffer += count;
+      break;
+  }
+
+  return ticks;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::process(Int16* buffer, uInt32 samples)
 {
@@ -321,40 +378,13 @@ void TIASound::process(Int16* buffer, uInt32 samples)
       }
     }
 
-    myOutputCounter += myOutputFrequency;
-
-    switch(myChannelMode)
-    {
-      case Hardware2Mono:  // mono sampling with 2 hardware channels
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          Int16 byte = v0 + v1;
-          *(buffer++) = byte;
-          *(buffer++) = byte;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
-
-      case Hardware2Stereo:  // stereo sampling with 2 hardware channels
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          *(buffer++) = v0;
-          *(buffer++) = v1;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
-
-      case Hardware1:  // mono/stereo sampling with only 1 hardware channel
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          *(buffer++) = v0 + v1;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
-    }
+    // A channel only changes its output when its 'divide by n' counter
+    // runs out; until one of them does, all samples are the same
+    uInt32 ticks = std::min(div_n_cnt0 ? div_n_cnt0 : ~0u,
+                            div_n_cnt1 ? div_n_cnt1 : ~0u);
+    ticks = output(buffer, samples, ticks, v0, v1) - 1;
+    if (div_n_cnt0) div_n_cnt0 -= ticks;
+    if (div_n_cnt1) div_n_cnt1 -= ticks;
   }
 
   // Save for next round
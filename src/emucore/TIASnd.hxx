@@ -94,6 +94,21 @@ class TIASound
   private:
     void polyInit(uInt8* poly, int size, int f0, int f1);
 
+    /**
+      Output the given channel values for (up to) the given number of
+      ticks at 31400Hz, stopping early when the buffer is full.
+
+      @param buffer   The location to store the samples; advanced past them
+      @param samples  The space left in the buffer; reduced accordingly
+      @param ticks    The maximum number of ticks to output
+      @param v0       The output of channel 0
+      @param v1       The output of channel 1
+
+      @return  The number of ticks actually output
+    */
+    uInt32 output(Int16*& buffer, uInt32& samples, uInt32 ticks,
+                  Int16 v0, Int16 v1);
+
   private:
     // Definitions for AUDCx (15, 16)
     enum AUDCxRegister
@@ -17,6 +17,14 @@
 
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define TIA_PHOSPHOR_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define TIA_PHOSPHOR_NEON
+#endif
+
 #include "FrameBuffer.hxx"
 #include "FBSurface.hxx"
 #include "Settings.hxx"
@@ -33,8 +41,17 @@ TIASurface::TIASurface(OSystem& system)
     myFilter(Filter::Normal),
     myUsePhosphor(false),
     myPhosphorPercent(0.60f),
+    myPhosphorFactor(0),
     myScanlinesEnabled(false),
-    myPalette(nullptr)
+    myPalette(nullptr),
+    myRenderAll(true),
+    myFrame(nullptr),
+    myFrameHeight(0),
+    myConvertedAll(true),
+    myPipelined(false),
+    myFramePending(false),
+    myConversionRequested(false),
+    myConversionQuit(false)
 {
   // Load NTSC filter settings
   myNTSCFilter.loadConfig(myOSystem.settings());
@@ -57,12 +74,27 @@ TIASurface::TIASurface(OSystem& system)
   memset(myRGBFramebuffer, 0, AtariNTSC::outWidth(kTIAW) * kTIAH);
 
   // Enable/disable threading in the NTSC TV effects renderer
-  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"));
+  myNTSCFilter.enableThreading(myOSystem.settings().getBool("threads"),
+                               myOSystem.settings().getInt("threadcount"),
+                               myOSystem.settings().getBool("threadaffinity"));
+
+  // Convert each frame while the next one is emulated
+  if(myOSystem.settings().getString("pipeline") == "throughput")
+    startConversionThread();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TIASurface::~TIASurface()
+{
+  stopConversionThread();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::initialize(const Console& console, const VideoMode& mode)
 {
+  // The surfaces may not be touched while a frame is being converted
+  invalidate();
+
   myTIA = &(console.tia());
 
   myTiaSurface->setDstPos(mode.image.x(), mode.image.y());
@@ -100,6 +132,8 @@ cerr << "SLine:\n"
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::setPalette(const uInt32* tia_palette, const uInt32* rgb_palette)
 {
+  invalidate();
+
   myPalette = tia_palette;
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
@@ -110,6 +144,8 @@ void TIASurface::setPalette(const uInt32* tia_palette, const uInt32* rgb_palette
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const FBSurface& TIASurface::baseSurface(GUI::Rect& rect) const
 {
+  finishConversion();
+
   uInt32 tiaw = myTIA->width(), width = tiaw * 2, height = myTIA->height();
   rect.setBounds(0, 0, width, height);
 
@@ -222,6 +258,8 @@ void TIASurface::enableScanlineInterpolation(bool enable)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::enablePhosphor(bool enable, int blend)
 {
+  invalidate();
+
   myUsePhosphor = enable;
   if(blend >= 0)
     myPhosphorPercent = blend / 100.0;
@@ -239,6 +277,23 @@ void TIASurface::enablePhosphor(bool enable, int blend)
         myPhosphorPalette[c][p] = getPhosphor(c, p);
 
     myNTSCFilter.setPhosphorPalette(myPhosphorPalette);
+
+    // Look for a fixed-point factor which decays every channel value exactly
+    // like getPhosphor() does, so that blending can be done arithmetically
+    myPhosphorFactor = 0;
+    const Int32 guess = Int32(myPhosphorPercent * 32768);
+    for(Int32 f = std::max(guess - 2, 1); f <= std::min(guess + 2, 32768); ++f)
+    {
+      bool exact = true;
+      for(uInt32 p = 0; p < 256 && exact; ++p)
+        exact = (p * f) >> 15 == getPhosphor(0, p);
+
+      if(exact)
+      {
+        myPhosphorFactor = f;
+        break;
+      }
+    }
   }
 }
 
@@ -259,9 +314,96 @@ inline uInt32 TIASurface::getRGBPhosphor(const uInt32 c, const uInt32 p) const
   return (rn << 16) | (gn << 8) | bn;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIASurface::blendPhosphorLine(const uInt8* tiaIn, uInt32* rgbIn,
+                                   uInt32* out, uInt32 width) const
+{
+  uInt32 x = 0, changed = 0;
+
+  // Each channel becomes max(current, (previous * factor) >> 15), four
+  // pixels at a time; the unused top byte is cleared like getRGBPhosphor()
+#if defined(TIA_PHOSPHOR_SSE2)
+  if(myPhosphorFactor)
+  {
+    const __m128i factor = _mm_set1_epi16(Int16(myPhosphorFactor));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbMask = _mm_set1_epi32(0x00ffffff);
+    auto blend = [&](__m128i c, __m128i p) {
+      return _mm_max_epi16(c, _mm_mulhi_epu16(_mm_slli_epi16(p, 1), factor));
+    };
+
+    __m128i diff = zero;
+    for(; x + 4 <= width; x += 4)
+    {
+      const __m128i c = _mm_set_epi32(
+          Int32(myPalette[tiaIn[x+3]]), Int32(myPalette[tiaIn[x+2]]),
+          Int32(myPalette[tiaIn[x+1]]), Int32(myPalette[tiaIn[x]]));
+      const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgbIn + x));
+
+      __m128i rgb = _mm_packus_epi16(
+          blend(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(p, zero)),
+          blend(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(p, zero)));
+      rgb = _mm_and_si128(rgb, rgbMask);
+
+      diff = _mm_or_si128(diff, _mm_xor_si128(rgb, p));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(rgbIn + x), rgb);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), rgb);
+    }
+    changed = _mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)) != 0xffff;
+  }
+#elif defined(TIA_PHOSPHOR_NEON)
+  if(myPhosphorFactor)
+  {
+    const uint16x4_t factor = vdup_n_u16(uInt16(myPhosphorFactor));
+    const uint32x4_t rgbMask = vdupq_n_u32(0x00ffffff);
+    auto blend = [&](uint8x8_t c, uint8x8_t p) {
+      const uint16x8_t p16 = vmovl_u8(p);
+      const uint16x8_t decay = vcombine_u16(
+          vshrn_n_u32(vmull_u16(vget_low_u16(p16), factor), 15),
+          vshrn_n_u32(vmull_u16(vget_high_u16(p16), factor), 15));
+      return vmovn_u16(vmaxq_u16(vmovl_u8(c), decay));
+    };
+
+    uint32x4_t diff = vdupq_n_u32(0);
+    for(; x + 4 <= width; x += 4)
+    {
+      const uInt32 colors[4] = {
+        myPalette[tiaIn[x]], myPalette[tiaIn[x+1]],
+        myPalette[tiaIn[x+2]], myPalette[tiaIn[x+3]]
+      };
+      const uint8x16_t c = vreinterpretq_u8_u32(vld1q_u32(colors));
+      const uint32x4_t p = vld1q_u32(rgbIn + x);
+      const uint8x16_t p8 = vreinterpretq_u8_u32(p);
+
+      uint32x4_t rgb = vreinterpretq_u32_u8(vcombine_u8(
+          blend(vget_low_u8(c), vget_low_u8(p8)),
+          blend(vget_high_u8(c), vget_high_u8(p8))));
+      rgb = vandq_u32(rgb, rgbMask);
+
+      diff = vorrq_u32(diff, veorq_u32(rgb, p));
+      vst1q_u32(rgbIn + x, rgb);
+      vst1q_u32(out + x, rgb);
+    }
+    const uint32x2_t d = vorr_u32(vget_low_u32(diff), vget_high_u32(diff));
+    changed = vget_lane_u32(d, 0) | vget_lane_u32(d, 1);
+  }
+#endif
+
+  for(; x < width; ++x)
+  {
+    const uInt32 rgb = getRGBPhosphor(myPalette[tiaIn[x]], rgbIn[x]);
+    changed |= rgb ^ rgbIn[x];
+    rgbIn[x] = out[x] = rgb;
+  }
+
+  return changed != 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::enableNTSC(bool enable)
 {
+  invalidate();
+
   myFilter = Filter(enable ? uInt8(myFilter) | 0x10 : uInt8(myFilter) & 0x01);
 
   // Normal vs NTSC mode uses different source widths
@@ -310,11 +452,146 @@ string TIASurface::effectsInfo() const
   return buf.str();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::invalidate()
+{
+  // A frame which was converted ahead is outdated now
+  finishConversion();
+  myFramePending = false;
+
+  myRenderAll = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIASurface::needsRender()
+{
+  if(myFramePending)
+  {
+    finishConversion();
+    return myConvertedAll || !myConvertedRows.empty();
+  }
+
+  // Blargg phosphor blending is only done on whole frames
+  return myRenderAll || myFilter == Filter::BlarggPhosphor ||
+         myTIA->hasDirtyLines() || myPhosphorLines.any();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TIASurface::isLineDirty(uInt32 y) const
+{
+  return myFrameLines[y] || myPhosphorLines[y];
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::render()
 {
-  uInt32 width  = myTIA->width();
-  uInt32 height = myTIA->height();
+  if(myFramePending)
+  {
+    finishConversion();
+    myFramePending = false;
+  }
+  else
+  {
+    captureFrame(myTIA->frameBuffer());
+    convertFrame();
+  }
+  presentFrame();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::startRender()
+{
+  if(!myPipelined)
+    return;
+
+  // The TIA keeps emulating into its own frame buffer, so the conversion
+  // thread gets a copy
+  finishConversion();
+  memcpy(myPipelineFrame, myTIA->frameBuffer(), kTIAW * myTIA->height());
+  captureFrame(myPipelineFrame);
+
+  {
+    std::lock_guard<std::mutex> lock(myConversionMutex);
+    myConversionRequested = true;
+  }
+  myConversionCondition.notify_all();
+  myFramePending = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::captureFrame(const uInt8* frame)
+{
+  myFrame = frame;
+  myFrameHeight = myTIA->height();
+  myFrameLines = myTIA->dirtyLines();
+  myTIA->clearDirtyLines();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::convertFrame()
+{
+  myConvertedRows.clear();
+
+  // Blargg phosphor blending is only done on whole frames
+  myConvertedAll = myRenderAll || myFilter == Filter::BlarggPhosphor;
+  if(myConvertedAll)
+  {
+    myPhosphorLines.reset();
+    renderLines(0, myFrameHeight);
+  }
+  else
+  {
+    // Only convert and transfer the scanlines which changed since the last
+    // frame, in runs of consecutive lines
+    for(uInt32 y = 0; y < myFrameHeight; )
+    {
+      if(!isLineDirty(y))
+      {
+        ++y;
+        continue;
+      }
+      uInt32 end = y + 1;
+      while(end < myFrameHeight && isLineDirty(end))
+        ++end;
+
+      renderLines(y, end);
+      myConvertedRows.emplace_back(y, end - y);
+      y = end;
+    }
+  }
+  myRenderAll = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::presentFrame()
+{
+  if(myConvertedAll)
+    myTiaSurface->setDirty();
+  else
+  {
+    for(const auto& rows: myConvertedRows)
+      myTiaSurface->setDirtyRows(rows.first, rows.second);
+
+    // The image must be redrawn in any case
+    myTiaSurface->setDirtyRows(0, 0);
+  }
+
+  // Draw TIA image
+  myTiaSurface->render();
+
+  // Draw overlaying scanlines
+  if(myScanlinesEnabled)
+  {
+    mySLineSurface->setDirty();
+    mySLineSurface->render();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::renderLines(uInt32 yStart, uInt32 yEnd)
+{
+  uInt32 width  = kTIAW;
+  uInt32 height = yEnd - yStart;
 
   uInt32 *out, outPitch;
   myTiaSurface->basePtr(out, outPitch);
@@ -323,9 +600,9 @@ void TIASurface::render()
   {
     case Filter::Normal:
     {
-      uInt8* tiaIn = myTIA->frameBuffer();
+      const uInt8* tiaIn = myFrame;
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
+      uInt32 bufofs = yStart * width, screenofsY = yStart * outPitch, pos;
       for(uInt32 y = 0; y < height; ++y)
       {
         pos = screenofsY;
@@ -341,54 +618,45 @@ void TIASurface::render()
 
     case Filter::Phosphor:
     {
-      uInt8*  tiaIn = myTIA->frameBuffer();
-      uInt32* rgbIn = myRGBFramebuffer;
+      const uInt8* tiaIn = myFrame + yStart * width;
+      uInt32* rgbIn = myRGBFramebuffer + yStart * width;
+      uInt32* screen = out + yStart * outPitch;
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
-      for(uInt32 y = height; y ; --y)
+      for(uInt32 y = yStart; y < yEnd; ++y)
       {
-        pos = screenofsY;
-        for(uInt32 x = width / 2; x ; --x)
-        {
-          // Store back into displayed frame buffer (for next frame)
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          bufofs++;
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          bufofs++;
-        }
-        screenofsY += outPitch;
+        // Store back into displayed frame buffer (for next frame); a line
+        // has settled once blending doesn't change it anymore
+        myPhosphorLines[y] = blendPhosphorLine(tiaIn, rgbIn, screen, width);
+
+        tiaIn  += width;
+        rgbIn  += width;
+        screen += outPitch;
       }
       break;
     }
 
     case Filter::BlarggNormal:
     {
-      myNTSCFilter.render(myTIA->frameBuffer(), width, height, out, outPitch << 2);
+      myNTSCFilter.render(myFrame + yStart * width, width, height,
+                          out + yStart * outPitch, outPitch << 2);
       break;
     }
 
     case Filter::BlarggPhosphor:
     {
-      myNTSCFilter.render(myTIA->frameBuffer(), width, height, out, outPitch << 2, myRGBFramebuffer);
+      myNTSCFilter.render(myFrame + yStart * width, width, height,
+                          out + yStart * outPitch, outPitch << 2,
+                          myRGBFramebuffer + yStart * outPitch);
       break;
     }
   }
-
-  // Draw TIA image
-  myTiaSurface->setDirty();
-  myTiaSurface->render();
-
-  // Draw overlaying scanlines
-  if(myScanlinesEnabled)
-  {
-    mySLineSurface->setDirty();
-    mySLineSurface->render();
-  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::reRender()
 {
+  finishConversion();
+
   uInt32 width = myTIA->width();
   uInt32 height = myTIA->height();
   uInt32 pos = 0;
@@ -401,6 +669,7 @@ void TIASurface::reRender()
     // for non-phosphor modes, render the frame again
     case Filter::Normal:
     case Filter::BlarggNormal:
+      invalidate();
       render();
       break;
     // for phosphor modes, copy the phosphor framebuffer
@@ -431,3 +700,60 @@ void TIASurface::reRender()
     }
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::startConversionThread()
+{
+  stopConversionThread();
+
+  myConversionQuit = false;
+  myConversionThread = std::thread([this] { conversionThread(); });
+  myPipelined = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::stopConversionThread()
+{
+  if(!myPipelined)
+    return;
+
+  finishConversion();
+  {
+    std::lock_guard<std::mutex> lock(myConversionMutex);
+    myConversionQuit = true;
+  }
+  myConversionCondition.notify_all();
+  myConversionThread.join();
+  myPipelined = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::conversionThread()
+{
+  std::unique_lock<std::mutex> lock(myConversionMutex);
+  for(;;)
+  {
+    myConversionCondition.wait(lock, [this] {
+      return myConversionRequested || myConversionQuit;
+    });
+    if(myConversionQuit)
+      return;
+
+    lock.unlock();
+    convertFrame();
+    lock.lock();
+
+    myConversionRequested = false;
+    myConversionCondition.notify_all();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::finishConversion() const
+{
+  if(!myPipelined)
+    return;
+
+  std::unique_lock<std::mutex> lock(myConversionMutex);
+  myConversionCondition.wait(lock, [this] { return !myConversionRequested; });
+}
@@ -26,6 +26,9 @@ class FBSurface;
 class VideoMode;
 
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <bitset>
 
 #include "Rect.hxx"
 #include "NTSCFilter.hxx"
@@ -49,6 +52,11 @@ class TIASurface
     */
     TIASurface(OSystem& system);
 
+    /**
+      Destructor
+    */
+    ~TIASurface();
+
     /**
       Set the TIA object, which is needed for actually rendering the TIA image.
     */
@@ -79,7 +87,8 @@ class TIASurface
     uInt32 pixel(uInt32 idx, uInt8 shift = 0);
 
     /**
-      Get the NTSCFilter object associated with the framebuffer
+      Get the NTSCFilter object associated with the framebuffer.  Callers
+      which change the filter must call invalidate() first.
     */
     NTSCFilter& ntsc() { return myNTSCFilter; }
 
@@ -139,6 +148,19 @@ class TIASurface
     */
     uInt32 getRGBPhosphor(const uInt32 c, const uInt32 cp) const;
 
+    /**
+      Blend one scanline of the TIA image with the previous frame.
+
+      @param tiaIn  TIA pixels (palette indices) of the line
+      @param rgbIn  Previous frame of the line; receives the blended pixels
+      @param out    Receives the blended pixels
+      @param width  Number of pixels
+
+      @return  Whether any pixel differs from the previous frame
+    */
+    bool blendPhosphorLine(const uInt8* tiaIn, uInt32* rgbIn, uInt32* out,
+                           uInt32 width) const;
+
     /**
       Enable/disable/query NTSC filtering effects.
     */
@@ -148,14 +170,85 @@ class TIASurface
 
     /**
       This method should be called to draw the TIA image(s) to the screen.
+      If a frame was handed off by startRender(), it waits for its
+      conversion and draws that frame instead of the current one.
     */
     void render();
 
+    /**
+      In pipelined mode, hand off a copy of the current frame to be
+      converted on another thread, while the next frame is emulated.
+      The converted frame is drawn by the next call to render().
+      Otherwise, this method does nothing.
+    */
+    void startRender();
+
+    /**
+      Answers whether frames are converted ahead by startRender().
+    */
+    bool pipelined() const { return myPipelined; }
+
     /**
       This method renders the current frame again.
     */
     void reRender();
 
+    /**
+      Normally, render() only converts and transfers the scanlines which
+      changed in the TIA. After a change of palette, filter, etc., this
+      method forces the next frame to be rendered in full.
+    */
+    void invalidate();
+
+    /**
+      Answers whether render() would change anything on screen.
+    */
+    bool needsRender();
+
+  private:
+    /**
+      Take over the given frame and the scanlines which changed in the TIA
+      as the next frame to convert.
+    */
+    void captureFrame(const uInt8* frame);
+
+    /**
+      Convert the captured frame to the TIA surface, and note the scanlines
+      which must be transferred to the screen.
+    */
+    void convertFrame();
+
+    /**
+      Transfer the converted frame to the screen.
+    */
+    void presentFrame();
+
+    /**
+      Convert the given scanlines of the captured frame to the TIA surface.
+    */
+    void renderLines(uInt32 yStart, uInt32 yEnd);
+
+    /**
+      Start/stop the thread which converts frames in pipelined mode.
+    */
+    void startConversionThread();
+    void stopConversionThread();
+
+    /**
+      Converts the frames handed off by startRender().
+    */
+    void conversionThread();
+
+    /**
+      Wait until the frame handed off by startRender() has been converted.
+    */
+    void finishConversion() const;
+
+    /**
+      Scanlines which must be rendered this frame.
+    */
+    bool isLineDirty(uInt32 y) const;
+
   private:
     OSystem& myOSystem;
     FrameBuffer& myFB;
@@ -195,6 +288,10 @@ class TIASurface
 
     // Precalculated averaged phosphor colors
     uInt8 myPhosphorPalette[256][256];
+
+    // Fixed-point (1.15) equivalent of myPhosphorPercent which gives exactly
+    // the same results as the table above, or 0 if there is none
+    uInt32 myPhosphorFactor;
     /////////////////////////////////////////////////////////////
 
     // Use scanlines in TIA rendering mode
@@ -203,6 +300,42 @@ class TIASurface
     // Palette for normal TIA rendering mode
     const uInt32* myPalette;
 
+    // The whole frame must be rendered, not just the changed scanlines
+    bool myRenderAll;
+
+    // Scanlines whose phosphor blend hasn't settled yet
+    std::bitset<kTIAH> myPhosphorLines;
+
+    // The frame being converted, its height, and the scanlines which
+    // changed in it
+    const uInt8* myFrame;
+    uInt32 myFrameHeight;
+    std::bitset<kTIAH> myFrameLines;
+
+    // Runs of scanlines (start, count) which were converted, unless the
+    // whole frame was
+    vector<std::pair<uInt32, uInt32>> myConvertedRows;
+    bool myConvertedAll;
+
+    /////////////////////////////////////////////////////////////
+    // Pipelined mode items (the last frame is converted while the next
+    // one is emulated)
+    bool myPipelined;
+
+    // Copy of the last frame, owned by the conversion thread while the
+    // next frame is emulated
+    uInt8 myPipelineFrame[kTIAW * kTIAH];
+
+    // A frame was handed off, and hasn't been drawn yet
+    bool myFramePending;
+
+    std::thread myConversionThread;
+    mutable std::mutex myConversionMutex;
+    mutable std::condition_variable myConversionCondition;
+    bool myConversionRequested;
+    bool myConversionQuit;
+    /////////////////////////////////////////////////////////////
+
   private:
     // Following constructors and assignment operators not supported
     TIASurface() = delete;
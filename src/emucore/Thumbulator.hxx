@@ -96,6 +96,17 @@ class Thumbulator
     void setConsoleTiming(ConsoleTiming timing);
 
   private:
+    // The Thumb instructions understood by execute()
+    enum class Op : uInt8 {
+      invalid, adc, add1, add2, add3, add4, add5, add6, add7, and_, asr1,
+      asr2, b1, b2, bic, bkpt, bl, blx2, bx, cmn, cmp1, cmp2, cmp3, cps, cpy,
+      eor, ldmia, ldr1, ldr2, ldr3, ldr4, ldrb1, ldrb2, ldrh1, ldrh2, ldrsb,
+      ldrsh, lsl1, lsl2, lsr1, lsr2, mov1, mov2, mov3, mul, mvn, neg, orr,
+      pop, push, rev, rev16, revsh, ror, sbc, setend, stmia, str1, str2, str3,
+      strb1, strb2, strh1, strh2, sub1, sub2, sub3, sub4, swi, sxtb, sxth,
+      tst, uxtb, uxth
+    };
+
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
     uInt32 fetch16(uInt32 addr);
@@ -125,6 +136,9 @@ class Thumbulator
     int execute();
     int reset();
 
+    // Fill the instruction decode table; see decodeTable below
+    static void buildDecodeTable();
+
   private:
     const uInt16* rom;
     uInt16* ram;
@@ -146,6 +160,11 @@ class Thumbulator
 
     static bool trapOnFatal;
 
+    // Maps each 16-bit opcode to its instruction, so that execute() needs
+    // only one lookup instead of testing the patterns one by one
+    static Op decodeTable[1 << 16];
+    static bool decodeTableBuilt;
+
     ConfigureFor configuration;
 
     Cartridge* myCartridge;
@@ -207,6 +207,24 @@ void Ball::tick(bool isReceivingMclock)
       myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Ball::tickSpan(uInt32 x, uInt32 clocks, SpanMask& coverage)
+{
+  for (uInt32 i = 0; i < clocks; i++) {
+    // Shortcut for the (common) clocks where the ball is neither drawn
+    // nor started; this is exactly what tick() does in that case
+    if (!myIsRendering && myCounter != 156) {
+      collision = myCollisionMaskDisabled;
+      if (++myCounter >= 160) myCounter = 0;
+
+      continue;
+    }
+
+    tick();
+    if (isOn()) coverage.set(x + i);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Ball::setENABLOld(bool enabled)
 {
@@ -19,6 +19,7 @@
 #define TIA_BALL
 
 #include "Serializable.hxx"
+#include "SpanMask.hxx"
 #include "bspf.hxx"
 
 class TIA;
@@ -62,9 +63,15 @@ class Ball : public Serializable
 
     void tick(bool isReceivingMclock = true);
 
+    void tickSpan(uInt32 x, uInt32 clocks, SpanMask& coverage);
+
     bool isOn() const { return (collision & 0x8000); }
     uInt8 getColor() const { return myColor; }
 
+    uInt32 getCollision(bool isOn) const {
+      return isOn ? myCollisionMaskEnabled : myCollisionMaskDisabled;
+    }
+
     void shuffleStatus();
 
     uInt8 getPosition() const;
@@ -29,6 +29,8 @@ class DelayQueueIteratorImpl;
 template<unsigned length, unsigned capacity>
 class DelayQueue : public Serializable
 {
+  static_assert(length < 32, "occupancy mask must hold one bit per queue member");
+
   public:
     friend DelayQueueIteratorImpl<length, capacity>;
 
@@ -43,6 +45,18 @@ class DelayQueue : public Serializable
 
     template<class T> void execute(T executor);
 
+    /**
+      The number of clocks following the current one during which no
+      writes are due; 'length' if the queue is empty.
+    */
+    uInt8 idleClocks() const;
+
+    /**
+      Skip the given number of clocks. There must be no writes due during
+      these clocks (see idleClocks()).
+    */
+    void skip(uInt8 clocks) { myIndex = smartmod<length>(myIndex + clocks); }
+
     /**
       Serializable methods (see that class for more information).
     */
@@ -50,11 +64,23 @@ class DelayQueue : public Serializable
     bool load(Serializer& in) override;
     string name() const override;
 
+  private:
+    /**
+      Recalculate the occupancy mask from the queue members.
+    */
+    void updateOccupancy();
+
   private:
     DelayQueueMember<capacity> myMembers[length];
     uInt8 myIndex;
     uInt8 myIndices[0xFF];
 
+    /**
+      Bit i is set iff member i contains any writes. This is derived from
+      the members and not part of the saved state.
+    */
+    uInt32 myOccupancy;
+
   private:
     DelayQueue(const DelayQueue&) = delete;
     DelayQueue(DelayQueue&&) = delete;
@@ -69,7 +95,8 @@ class DelayQueue : public Serializable
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 DelayQueue<length, capacity>::DelayQueue()
-  : myIndex(0)
+  : myIndex(0),
+    myOccupancy(0)
 {
   memset(myIndices, 0xFF, 0xFF);
 }
@@ -83,11 +110,14 @@ void DelayQueue<length, capacity>::push(uInt8 address, uInt8 value, uInt8 delay)
 
   uInt8 currentIndex = myIndices[address];
 
-  if (currentIndex < 0xFF)
+  if (currentIndex < 0xFF) {
     myMembers[currentIndex].remove(address);
+    if (myMembers[currentIndex].mySize == 0) myOccupancy &= ~(1 << currentIndex);
+  }
 
   uInt8 index = smartmod<length>(myIndex + delay);
   myMembers[index].push(address, value);
+  myOccupancy |= 1 << index;
 
   myIndices[address] = index;
 }
@@ -100,6 +130,7 @@ void DelayQueue<length, capacity>::reset()
     myMembers[i].clear();
 
   myIndex = 0;
+  myOccupancy = 0;
   memset(myIndices, 0xFF, 0xFF);
 }
 
@@ -108,6 +139,11 @@ template<unsigned length, unsigned capacity>
 template<class T>
 void DelayQueue<length, capacity>::execute(T executor)
 {
+  if (!(myOccupancy & (1 << myIndex))) {
+    myIndex = smartmod<length>(myIndex + 1);
+    return;
+  }
+
   DelayQueueMember<capacity>& currentMember = myMembers[myIndex];
 
   for (uInt8 i = 0; i < currentMember.mySize; i++) {
@@ -116,10 +152,31 @@ void DelayQueue<length, capacity>::execute(T executor)
   }
 
   currentMember.clear();
+  myOccupancy &= ~(1 << myIndex);
 
   myIndex = smartmod<length>(myIndex + 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+uInt8 DelayQueue<length, capacity>::idleClocks() const
+{
+  if (myOccupancy == 0) return length;
+
+  // Rotate the mask so that bit 0 corresponds to the current index; the
+  // number of trailing zeros is the number of idle clocks
+  uInt32 pending = (myOccupancy >> myIndex) | (myOccupancy << (length - myIndex));
+
+#if defined(__GNUC__)
+  return __builtin_ctz(pending);
+#else
+  uInt8 clocks = 0;
+  for (; !(pending & 0x01); pending >>= 1) clocks++;
+
+  return clocks;
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 bool DelayQueue<length, capacity>::save(Serializer& out) const
@@ -156,6 +213,8 @@ bool DelayQueue<length, capacity>::load(Serializer& in)
 
     myIndex = in.getByte();
     in.getByteArray(myIndices, 0xFF);
+
+    updateOccupancy();
   }
   catch(...)
   {
@@ -166,6 +225,16 @@ bool DelayQueue<length, capacity>::load(Serializer& in)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+void DelayQueue<length, capacity>::updateOccupancy()
+{
+  myOccupancy = 0;
+
+  for (uInt8 i = 0; i < length; i++)
+    if (myMembers[i].mySize > 0) myOccupancy |= 1 << i;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 string DelayQueue<length, capacity>::name() const
@@ -210,6 +210,24 @@ void Missile::tick(uInt8 hclock)
   if (++myCounter >= 160) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Missile::tickSpan(uInt32 x, uInt8 hclock, uInt32 clocks, SpanMask& coverage)
+{
+  for (uInt32 i = 0; i < clocks; i++) {
+    // Shortcut for the (common) clocks where the missile is neither drawn
+    // nor started; this is exactly what tick() does in that case
+    if (!myIsRendering && (!myDecodes[myCounter] || myResmp)) {
+      collision = myCollisionMaskDisabled;
+      if (++myCounter >= 160) myCounter = 0;
+
+      continue;
+    }
+
+    tick(hclock + i);
+    if (isOn()) coverage.set(x + i);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Missile::setColor(uInt8 color)
 {
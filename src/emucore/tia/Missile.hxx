@@ -19,6 +19,7 @@
 #define TIA_MISSILE
 
 #include "Serializable.hxx"
+#include "SpanMask.hxx"
 #include "bspf.hxx"
 #include "Player.hxx"
 
@@ -52,6 +53,8 @@ class Missile : public Serializable
 
     void tick(uInt8 hclock);
 
+    void tickSpan(uInt32 x, uInt8 hclock, uInt32 clocks, SpanMask& coverage);
+
     void setColor(uInt8 color);
 
     void setDebugColor(uInt8 color);
@@ -66,6 +69,10 @@ class Missile : public Serializable
     bool isOn() const { return (collision & 0x8000); }
     uInt8 getColor() const { return myColor; }
 
+    uInt32 getCollision(bool isOn) const {
+      return isOn ? myCollisionMaskEnabled : myCollisionMaskDisabled;
+    }
+
     uInt8 getPosition() const;
     void setPosition(uInt8 newPosition);
 
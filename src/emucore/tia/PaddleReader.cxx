@@ -26,7 +26,7 @@ PaddleReader::PaddleReader()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PaddleReader::reset(double timestamp)
+void PaddleReader::reset(uInt64 timestamp)
 {
   myU = 0;
   myIsDumped = false;
@@ -35,10 +35,11 @@ void PaddleReader::reset(double timestamp)
   myTimestamp = timestamp;
 
   setConsoleTiming(ConsoleTiming::ntsc);
+  updateTripTimestamp();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PaddleReader::vblank(uInt8 value, double timestamp)
+void PaddleReader::vblank(uInt8 value, uInt64 timestamp)
 {
   bool oldIsDumped = myIsDumped;
 
@@ -49,27 +50,22 @@ void PaddleReader::vblank(uInt8 value, double timestamp)
   } else if (oldIsDumped) {
     myIsDumped = false;
     myTimestamp = timestamp;
+    updateTripTimestamp();
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 PaddleReader::inpt(double timestamp)
-{
-  updateCharge(timestamp);
-
-  bool state = myIsDumped ? false : myU > myUThresh;
-
-  return state ? 0x80 : 0;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PaddleReader::update(double value, double timestamp, ConsoleTiming consoleTiming)
+void PaddleReader::update(double value, uInt64 timestamp, ConsoleTiming consoleTiming)
 {
   if (consoleTiming != myConsoleTiming) {
     setConsoleTiming(consoleTiming);
+    updateTripTimestamp();
   }
 
   if (value != myValue) {
+    // Charge up to now with the old resistance before switching
+    updateCharge(timestamp);
+
     myValue = value;
 
     if (myValue < 0) {
@@ -78,9 +74,9 @@ void PaddleReader::update(double value, double timestamp, ConsoleTiming consoleT
       // assume ground and discharge.
       myU = 0;
       myTimestamp = timestamp;
-    } else {
-      updateCharge(timestamp);
     }
+
+    updateTripTimestamp();
   }
 }
 
@@ -94,17 +90,39 @@ void PaddleReader::setConsoleTiming(ConsoleTiming consoleTiming)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PaddleReader::updateCharge(double timestamp)
+void PaddleReader::updateCharge(uInt64 timestamp)
 {
   if (myIsDumped) return;
 
   if (myValue >= 0)
     myU = USUPP * (1 - (1 - myU / USUPP) *
-      exp(-(timestamp - myTimestamp) / (myValue * RPOT + R0) / C / myClockFreq));
+      exp(-double(timestamp - myTimestamp) / (myValue * RPOT + R0) / C / myClockFreq));
 
   myTimestamp = timestamp;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PaddleReader::updateTripTimestamp()
+{
+  // A grounded input never trips
+  if (myValue < 0) {
+    myTripTimestamp = ~uInt64(0);
+    return;
+  }
+
+  if (myU > myUThresh) {
+    myTripTimestamp = myTimestamp;
+    return;
+  }
+
+  // Solve U(t) = USUPP * (1 - (1 - U0 / USUPP) * exp(-dt / tau)) for U(t) = UThresh;
+  // the input reads high on the first clock for which the voltage is above
+  const double dt = (myValue * RPOT + R0) * C * myClockFreq *
+    log((USUPP - myU) / (USUPP - myUThresh));
+
+  myTripTimestamp = dt < 1e15 ? myTimestamp + uInt64(dt) + 1 : ~uInt64(0);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool PaddleReader::save(Serializer& out) const
 {
@@ -116,7 +134,7 @@ bool PaddleReader::save(Serializer& out) const
     out.putDouble(myU);
 
     out.putDouble(myValue);
-    out.putDouble(myTimestamp);
+    out.putLong(myTimestamp);
 
     out.putInt(int(myConsoleTiming));
     out.putDouble(myClockFreq);
@@ -144,12 +162,14 @@ bool PaddleReader::load(Serializer& in)
     myU = in.getDouble();
 
     myValue = in.getDouble();
-    myTimestamp = in.getDouble();
+    myTimestamp = in.getLong();
 
     myConsoleTiming = ConsoleTiming(in.getInt());
     myClockFreq = in.getDouble();
 
     myIsDumped = in.getBool();
+
+    updateTripTimestamp();
   }
   catch(...)
   {
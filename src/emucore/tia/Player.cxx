@@ -309,6 +309,24 @@ void Player::tick()
   if (++myCounter >= 160) myCounter = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Player::tickSpan(uInt32 x, uInt32 clocks, SpanMask& coverage)
+{
+  for (uInt32 i = 0; i < clocks; i++) {
+    // Shortcut for the (common) clocks where no copy is drawn or started;
+    // this is exactly what tick() does in that case
+    if (!myIsRendering && !myDecodes[myCounter]) {
+      collision = myCollisionMaskDisabled;
+      if (++myCounter >= 160) myCounter = 0;
+
+      continue;
+    }
+
+    tick();
+    if (isOn()) coverage.set(x + i);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Player::shufflePatterns()
 {
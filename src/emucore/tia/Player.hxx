@@ -20,6 +20,7 @@
 
 #include "bspf.hxx"
 #include "Serializable.hxx"
+#include "SpanMask.hxx"
 
 class TIA;
 
@@ -62,11 +63,16 @@ class Player : public Serializable
     bool movementTick(uInt32 clock, bool apply);
 
     void tick();
+    void tickSpan(uInt32 x, uInt32 clocks, SpanMask& coverage);
     uInt8 getClock() const { return myCounter; }
 
     bool isOn() const { return (collision & 0x8000); }
     uInt8 getColor() const { return myColor; }
 
+    uInt32 getCollision(bool isOn) const {
+      return isOn ? myCollisionMaskEnabled : myCollisionMaskDisabled;
+    }
+
     void shufflePatterns();
 
     uInt8 getRespClock() const;
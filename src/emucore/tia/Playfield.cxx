@@ -204,6 +204,15 @@ void Playfield::tick(uInt32 x)
   collision = currentPixel ? myCollisionMaskEnabled : myCollisionMaskDisabled;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Playfield::tickSpan(uInt32 x, uInt32 clocks, SpanMask& coverage)
+{
+  for (uInt32 i = 0; i < clocks; i++) {
+    tick(x + i);
+    if (isOn()) coverage.set(x + i);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Playfield::applyColors()
 {
@@ -237,18 +246,18 @@ void Playfield::applyColors()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt8 Playfield::getColor() const
+uInt8 Playfield::getColor(uInt32 x) const
 {
   if (!myDebugEnabled)
-    return myX < 80 ? myColorLeft : myColorRight;
+    return x < 80 ? myColorLeft : myColorRight;
   else
   {
-    if (myX < 80)
+    if (x < 80)
     {
       // left side:
-      if(myX < 16)
+      if(x < 16)
         return myDebugColor - 2;    // PF0
-      if(myX < 48)
+      if(x < 48)
         return myDebugColor;        // PF1
     }
     else
@@ -256,16 +265,16 @@ uInt8 Playfield::getColor() const
       // right side:
       if(!myReflected)
       {
-        if(myX < 80 + 16)
+        if(x < 80 + 16)
           return myDebugColor - 2;  // PF0
-        if(myX < 80 + 48)
+        if(x < 80 + 48)
           return myDebugColor;      // PF1
       }
       else
       {
-        if(myX >= 160 - 16)
+        if(x >= 160 - 16)
           return myDebugColor - 2;  // PF0
-        if(myX >= 160 - 48)
+        if(x >= 160 - 48)
           return myDebugColor;      // PF1
       }
     }
@@ -19,6 +19,7 @@
 #define TIA_PLAYFIELD
 
 #include "Serializable.hxx"
+#include "SpanMask.hxx"
 #include "bspf.hxx"
 
 class TIA;
@@ -59,8 +60,20 @@ class Playfield : public Serializable
 
     void tick(uInt32 x);
 
+    void tickSpan(uInt32 x, uInt32 clocks, SpanMask& coverage);
+
     bool isOn() const { return (collision & 0x8000); }
-    uInt8 getColor() const;
+    uInt8 getColor() const { return getColor(myX); }
+
+    /**
+      The color of the playfield at pixel x. This is constant over each
+      (aligned) block of 16 pixels.
+    */
+    uInt8 getColor(uInt32 x) const;
+
+    uInt32 getCollision(bool isOn) const {
+      return isOn ? myCollisionMaskEnabled : myCollisionMaskDisabled;
+    }
 
     /**
       Serializable methods (see that class for more information).
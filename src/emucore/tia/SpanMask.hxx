@@ -0,0 +1,60 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2017 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef TIA_SPAN_MASK
+#define TIA_SPAN_MASK
+
+#include "bspf.hxx"
+
+/**
+  A bitmask with one bit per pixel of a scanline. The TIA uses these to
+  record which pixels of a span (a stretch of clocks without register
+  changes) are covered by each object, and then resolves the whole span
+  at once.
+
+  @author  Christian Speckner (DirtyHairy) and Stephen Anthony
+*/
+class SpanMask
+{
+  public:
+    /**
+      The number of 64 bit words in a mask. A scanline has 160 pixels, but
+      after a late RSYNC the objects may be clocked for up to two more.
+    */
+    static constexpr uInt32 words = 3;
+
+  public:
+    SpanMask() { clear(); }
+
+    void clear() { myBits[0] = myBits[1] = myBits[2] = 0; }
+
+    void set(uInt32 x) { myBits[x >> 6] |= uInt64(1) << (x & 0x3f); }
+
+    bool isSet(uInt32 x) const { return (myBits[x >> 6] >> (x & 0x3f)) & 0x01; }
+
+    /**
+      Get the 16 bits starting at x, which must be a multiple of 16.
+    */
+    uInt32 block(uInt32 x) const { return (myBits[x >> 6] >> (x & 0x3f)) & 0xffff; }
+
+    uInt64 word(uInt32 i) const { return myBits[i]; }
+
+  private:
+    uInt64 myBits[words];
+};
+
+#endif // TIA_SPAN_MASK
@@ -28,6 +28,15 @@
   #include "CartDebug.hxx"
 #endif
 
+// Spans of pixels are resolved 16 at a time, using SIMD where available
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define TIA_SPAN_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define TIA_SPAN_NEON
+#endif
+
 enum CollisionMask: uInt32 {
   player0   = 0b0111110000000000,
   player1   = 0b0100001111000000,
@@ -76,8 +85,11 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
     myPlayer0(~CollisionMask::player0 & 0x7FFF),
     myPlayer1(~CollisionMask::player1 & 0x7FFF),
     myBall(~CollisionMask::ball & 0x7FFF),
+    myLastFramebufferValid(false),
     mySpriteEnabledBits(0xFF),
-    myCollisionsEnabledBits(0xFF)
+    myCollisionsEnabledBits(0xFF),
+    myLogicOnly(false),
+    myRunAhead(false)
 {
   bool devSettings = mySettings.getBool("dev.settings");
   myTIAPinsDriven = mySettings.getBool(devSettings ? "dev.tiadriven" : "plr.tiadriven");
@@ -185,6 +197,7 @@ void TIA::reset()
 void TIA::frameReset()
 {
   memset(myFramebuffer, 0, 160 * TIAConstants::frameBufferHeight);
+  invalidateLines();
   myAutoFrameEnabled = mySettings.getInt("framerate") <= 0;
   enableColorLoss(mySettings.getBool("dev.settings") ? "dev.colorloss" : "plr.colorloss");
 }
@@ -225,7 +238,7 @@ bool TIA::save(Serializer& out) const
   {
     out.putString(name());
 
-    if(!mySound.save(out)) return false;
+    if(!myRunAhead && !mySound.save(out)) return false;
 
     if(!myDelayQueue.save(out))   return false;
     if(!myFrameManager->save(out)) return false;
@@ -271,7 +284,7 @@ bool TIA::save(Serializer& out) const
 
     out.putByte(myColorHBlank);
 
-    out.putDouble(myTimestamp);
+    out.putLong(myTimestamp);
 
     out.putBool(myAutoFrameEnabled);
 
@@ -296,7 +309,7 @@ bool TIA::load(Serializer& in)
     if(in.getString() != name())
       return false;
 
-    if(!mySound.load(in)) return false;
+    if(!myRunAhead && !mySound.load(in)) return false;
 
     if(!myDelayQueue.load(in))   return false;
     if(!myFrameManager->load(in)) return false;
@@ -342,7 +355,7 @@ bool TIA::load(Serializer& in)
 
     myColorHBlank = in.getByte();
 
-    myTimestamp = in.getDouble();
+    myTimestamp = in.getLong();
 
     myAutoFrameEnabled = in.getBool();
 
@@ -522,27 +535,17 @@ bool TIA::poke(uInt16 address, uInt8 value)
     ////////////////////////////////////////////////////////////
     // FIXME - rework this when we add the new sound core
     case AUDV0:
-      mySound.set(address, value, mySystem->cycles());
-      myShadowRegisters[address] = value;
-      break;
     case AUDV1:
-      mySound.set(address, value, mySystem->cycles());
-      myShadowRegisters[address] = value;
-      break;
     case AUDF0:
-      mySound.set(address, value, mySystem->cycles());
-      myShadowRegisters[address] = value;
-      break;
     case AUDF1:
-      mySound.set(address, value, mySystem->cycles());
-      myShadowRegisters[address] = value;
-      break;
     case AUDC0:
-      mySound.set(address, value, mySystem->cycles());
-      myShadowRegisters[address] = value;
-      break;
     case AUDC1:
-      mySound.set(address, value, mySystem->cycles());
+      if(!myRunAhead)
+      {
+        mySound.set(address, value, mySystem->cycles());
+        if(myAudioWriteCallback)
+          myAudioWriteCallback(address, value, mySystem->cycles());
+      }
       myShadowRegisters[address] = value;
       break;
     ////////////////////////////////////////////////////////////
@@ -793,6 +796,7 @@ bool TIA::loadDisplay(Serializer& in)
   {
     // Reset frame buffer pointer and data
     in.getByteArray(myFramebuffer, 160*TIAConstants::frameBufferHeight);
+    invalidateLines();
   }
   catch(...)
   {
@@ -1144,13 +1148,23 @@ void TIA::onFrameComplete()
   mySystem->m6502().stop();
   myCyclesAtFrameStart = mySystem->cycles();
 
-  if (myXAtRenderingStart > 0)
-    memset(myFramebuffer, 0, myXAtRenderingStart);
+  if (!myLogicOnly)
+  {
+    if (myXAtRenderingStart > 0)
+      memset(myFramebuffer, 0, myXAtRenderingStart);
+
+    // Blank out any extra lines not drawn this frame
+    const Int32 missingScanlines = myFrameManager->missingScanlines();
+    if (missingScanlines > 0)
+      memset(myFramebuffer + 160 * myFrameManager->getY(), 0, missingScanlines * 160);
+
+    updateDirtyLines();
+  }
+  myClonedLines.reset();
 
-  // Blank out any extra lines not drawn this frame
-  const Int32 missingScanlines = myFrameManager->missingScanlines();
-  if (missingScanlines > 0)
-    memset(myFramebuffer + 160 * myFrameManager->getY(), 0, missingScanlines * 160);
+  // Produce the sound of the whole frame, even if no registers changed
+  if(!myRunAhead)
+    mySound.update(mySystem->cycles());
 
   // Recalculate framerate, attempting to auto-correct for scanline 'jumps'
   if(myAutoFrameEnabled)
@@ -1176,16 +1190,42 @@ void TIA::cycle(uInt32 colorClocks)
 
     myCollisionUpdateRequired = false;
 
+    // Stretches of clocks that don't depend on anything but the counter are
+    // processed as a single batch. Pokes end the batch anyway, so it only
+    // needs to stop before the next delayed write and at the end of the line
+    uInt32 clocks = 1;
+
     if (myLinesSinceChange < 2) {
       tickMovement();
 
-      if (myHstate == HState::blank)
+      if (myHstate == HState::blank) {
         tickHblank();
-      else
+
+        // Without movement, nothing happens in hblank until the next
+        // counter value checked in tickHblank()
+        if (!myMovementInProgress && myHstate == HState::blank)
+          clocks = batchLength(colorClocks - i, myHctr < 67 ? 67 : (myHctr < 75 ? 75 : 228));
+      }
+      else if (myMovementInProgress)
         tickHframe();
+      else {
+        clocks = batchLength(colorClocks - i, 228);
+        tickHframeSpan(clocks);
+      }
 
       if (myCollisionUpdateRequired && !myFrameManager->vblank()) updateCollision();
     }
+    else
+      // The line cache takes care of the whole line when it wraps
+      clocks = batchLength(colorClocks - i, 228);
+
+    // The last clock of the batch is finished below, like any other
+    if (clocks > 1) {
+      myDelayQueue.skip(clocks - 1);
+      myHctr += clocks - 1;
+      myTimestamp += clocks - 1;
+      i += clocks - 1;
+    }
 
     if (++myHctr >= 228)
       nextLine();
@@ -1194,6 +1234,18 @@ void TIA::cycle(uInt32 colorClocks)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::batchLength(uInt32 maxClocks, uInt32 hctrLimit) const
+{
+  uInt32 clocks = std::min(maxClocks, hctrLimit - myHctr);
+  const uInt8 idleClocks = myDelayQueue.idleClocks();
+
+  if (idleClocks < delayQueueLength)
+    clocks = std::min(clocks, uInt32(idleClocks) + 1);
+
+  return clocks;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::tickMovement()
 {
@@ -1250,17 +1302,39 @@ void TIA::tickHframe()
   myPlayer1.tick();
   myBall.tick();
 
-  if (myFrameManager->isRendering())
+  if (isDrawing())
     renderPixel(x, y);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::tickHframeSpan(uInt32 clocks)
+{
+  const uInt32 y = myFrameManager->getY();
+  const uInt32 x = myHctr - 68 - myHctrDelta;
+
+  SpanMask coverage[6];
+
+  myPlayfield.tickSpan(x, clocks, coverage[FixedObject::PF]);
+  myMissile0.tickSpan(x, myHctr, clocks, coverage[FixedObject::M0]);
+  myMissile1.tickSpan(x, myHctr, clocks, coverage[FixedObject::M1]);
+  myPlayer0.tickSpan(x, clocks, coverage[FixedObject::P0]);
+  myPlayer1.tickSpan(x, clocks, coverage[FixedObject::P1]);
+  myBall.tickSpan(x, clocks, coverage[FixedObject::BL]);
+
+  if (isDrawing())
+    renderSpan(x, clocks, y, coverage);
+
+  if (!myFrameManager->vblank())
+    updateCollision(x, clocks, coverage);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::applyRsync()
 {
   const uInt32 x = myHctr > 68 ? myHctr - 68 : 0;
 
   myHctrDelta = 225 - myHctr;
-  if (myFrameManager->isRendering())
+  if (isDrawing())
     memset(myFramebuffer + myFrameManager->getY() * 160 + x, 0, 160 - x);
 
   myHctr = 225;
@@ -1292,11 +1366,51 @@ void TIA::cloneLastLine()
 {
   const auto y = myFrameManager->getY();
 
-  if (!myFrameManager->isRendering() || y == 0) return;
+  if (!isDrawing() || y == 0) return;
 
   uInt8* buffer = myFramebuffer;
 
   memcpy(buffer + y * 160, buffer + (y-1) * 160, 160);
+  myClonedLines.set(y);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::updateDirtyLines()
+{
+  if (!myLastFramebufferValid) {
+    memcpy(myLastFramebuffer, myFramebuffer, 160 * TIAConstants::frameBufferHeight);
+    myDirtyLines.set();
+    myLastFramebufferValid = true;
+  }
+  else {
+    // A line which the line cache copied from the line above, in this frame
+    // as well as in the last one, changed exactly when the line above did;
+    // only the other lines have to be compared. Line 1 is always compared,
+    // since line 0 may be blanked partially after being copied.
+    bool lastLineChanged = true;
+    for (uInt32 y = 0, offset = 0; y < TIAConstants::frameBufferHeight; ++y, offset += 160) {
+      const bool changed = (y > 1 && myClonedLines[y] && myLastClonedLines[y]) ?
+        lastLineChanged :
+        memcmp(myFramebuffer + offset, myLastFramebuffer + offset, 160) != 0;
+
+      if (changed) {
+        memcpy(myLastFramebuffer + offset, myFramebuffer + offset, 160);
+        myDirtyLines.set(y);
+      }
+      lastLineChanged = changed;
+    }
+  }
+
+  myLastClonedLines = myClonedLines;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::invalidateLines()
+{
+  myLastFramebufferValid = false;
+  myClonedLines.reset();
+  myLastClonedLines.reset();
+  myDirtyLines.set();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1312,6 +1426,59 @@ void TIA::updateCollision()
   );
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::updateCollision(uInt32 x, uInt32 clocks, const SpanMask* coverage)
+{
+  const uInt32 collisionOn[6] = {
+    myPlayer0.getCollision(true), myMissile0.getCollision(true),
+    myPlayer1.getCollision(true), myMissile1.getCollision(true),
+    myPlayfield.getCollision(true), myBall.getCollision(true)
+  };
+  const uInt32 collisionOff[6] = {
+    myPlayer0.getCollision(false), myMissile0.getCollision(false),
+    myPlayer1.getCollision(false), myMissile1.getCollision(false),
+    myPlayfield.getCollision(false), myBall.getCollision(false)
+  };
+
+  // A bit can only be set if, for every object, the object's state at some
+  // pixel allows it. Bits that are already latched need no further work.
+  uInt32 candidates = 0xFFFF & ~myCollisionMask;
+  for (uInt32 i = 0; i < 6; i++)
+    candidates &= collisionOn[i] | collisionOff[i];
+
+  if (!candidates) return;
+
+  // The pixels of the span, one bit per pixel
+  uInt64 range[SpanMask::words];
+  for (uInt32 w = 0; w < SpanMask::words; w++) {
+    const uInt32 lo = std::max(x, w << 6), hi = std::min(x + clocks, (w + 1) << 6);
+
+    range[w] = lo >= hi ? 0 :
+      (hi - lo == 64 ? ~uInt64(0) : ((uInt64(1) << (hi - lo)) - 1) << (lo & 0x3f));
+  }
+
+  // For each candidate bit, intersect the pixels at which every object is
+  // in a state that sets the bit; it is latched if any pixel remains
+  for (uInt32 bit = 0; bit < 16; bit++) {
+    const uInt32 b = 1 << bit;
+    if (!(candidates & b)) continue;
+
+    uInt64 hit = 0;
+    for (uInt32 w = 0; w < SpanMask::words; w++) {
+      uInt64 pixels = range[w];
+
+      for (uInt32 i = 0; i < 6 && pixels; i++) {
+        if (!(collisionOff[i] & b))       pixels &= coverage[i].word(w);
+        else if (!(collisionOn[i] & b))   pixels &= ~coverage[i].word(w);
+      }
+
+      hit |= pixels;
+    }
+
+    if (hit) myCollisionMask |= b;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::renderPixel(uInt32 x, uInt32 y)
 {
@@ -1370,6 +1537,121 @@ void TIA::renderPixel(uInt32 x, uInt32 y)
   myFramebuffer[y * 160 + x] = color;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace {
+  /**
+    Render 16 pixels to dst: start out with the background color, then
+    paint the six objects over it in order of increasing priority (bit i
+    of a mask corresponds to pixel i). Only pixels selected by 'range'
+    are written.
+  */
+  inline void renderBlock(uInt8* dst, uInt32 range, uInt8 background,
+                          const uInt32* masks, const uInt8* colors)
+  {
+  #if defined(TIA_SPAN_SSE2)
+    const __m128i bits = _mm_set_epi8(-128, 64, 32, 16, 8, 4, 2, 1,
+                                      -128, 64, 32, 16, 8, 4, 2, 1);
+
+    // Spread 16 mask bits over 16 bytes (0x00 or 0xff)
+    auto expand = [&bits](uInt32 mask) {
+      __m128i v = _mm_cvtsi32_si128(Int32(mask));
+      v = _mm_unpacklo_epi8(v, v);
+      v = _mm_unpacklo_epi16(v, v);
+      v = _mm_unpacklo_epi32(v, v);
+
+      return _mm_cmpeq_epi8(_mm_and_si128(v, bits), bits);
+    };
+    auto select = [](__m128i mask, __m128i a, __m128i b) {
+      return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    };
+
+    __m128i pixels = _mm_set1_epi8(char(background));
+    for (uInt32 i = 0; i < 6; i++)
+      if (masks[i])
+        pixels = select(expand(masks[i]), _mm_set1_epi8(char(colors[i])), pixels);
+
+    __m128i* p = reinterpret_cast<__m128i*>(dst);
+    _mm_storeu_si128(p, select(expand(range), pixels, _mm_loadu_si128(p)));
+  #elif defined(TIA_SPAN_NEON)
+    static const uInt8 bitValues[16] = {
+      1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+    };
+    const uint8x16_t bits = vld1q_u8(bitValues);
+
+    // Spread 16 mask bits over 16 bytes (0x00 or 0xff)
+    auto expand = [&bits](uInt32 mask) {
+      return vtstq_u8(vcombine_u8(vdup_n_u8(mask & 0xff), vdup_n_u8(mask >> 8)), bits);
+    };
+
+    uint8x16_t pixels = vdupq_n_u8(background);
+    for (uInt32 i = 0; i < 6; i++)
+      if (masks[i])
+        pixels = vbslq_u8(expand(masks[i]), vdupq_n_u8(colors[i]), pixels);
+
+    vst1q_u8(dst, vbslq_u8(expand(range), pixels, vld1q_u8(dst)));
+  #else
+    for (uInt32 x = 0; x < 16; x++) {
+      if (!(range & (1 << x))) continue;
+
+      uInt8 color = background;
+      for (uInt32 i = 0; i < 6; i++)
+        if (masks[i] & (1 << x)) color = colors[i];
+
+      dst[x] = color;
+    }
+  #endif
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::renderSpan(uInt32 x, uInt32 clocks, uInt32 y, const SpanMask* coverage)
+{
+  const uInt32 xEnd = std::min(x + clocks, 160u);
+  if (x >= xEnd) return;
+
+  uInt8* line = myFramebuffer + y * 160;
+
+  if (myFrameManager->vblank()) {
+    memset(line + x, 0, xEnd - x);
+    return;
+  }
+
+  // The objects in order of increasing priority, for each mode of the
+  // priority encoder (see renderPixel)
+  static constexpr FixedObject layers[3][6] = {
+    { M1, P1, M0, P0, BL, PF },  // Priority::pfp
+    { BL, M1, P1, PF, M0, P0 },  // Priority::score
+    { BL, PF, M1, P1, M0, P0 }   // Priority::normal
+  };
+  const FixedObject* order = layers[myPriority];
+
+  uInt8 objectColors[6];
+  objectColors[FixedObject::P0] = myPlayer0.getColor();
+  objectColors[FixedObject::M0] = myMissile0.getColor();
+  objectColors[FixedObject::P1] = myPlayer1.getColor();
+  objectColors[FixedObject::M1] = myMissile1.getColor();
+  objectColors[FixedObject::BL] = myBall.getColor();
+
+  uInt32 masks[6];
+  uInt8 colors[6];
+
+  for (uInt32 block = x & ~0x0f; block < xEnd; block += 16) {
+    // The pixels of this block that are part of the span
+    uInt32 range = 0xffff;
+    if (block < x) range &= 0xffff << (x - block);
+    if (block + 16 > xEnd) range &= 0xffff >> (block + 16 - xEnd);
+
+    objectColors[FixedObject::PF] = myPlayfield.getColor(block);
+
+    for (uInt32 i = 0; i < 6; i++) {
+      masks[i] = coverage[order[i]].block(block);
+      colors[i] = objectColors[order[i]];
+    }
+
+    renderBlock(line + block, range, myBackground.getColor(), masks, colors);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::flushLineCache()
 {
@@ -1392,7 +1674,7 @@ void TIA::flushLineCache()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::clearHmoveComb()
 {
-  if (myFrameManager->isRendering() && myHstate == HState::blank)
+  if (isDrawing() && myHstate == HState::blank)
     memset(myFramebuffer + myFrameManager->getY() * 160, myColorHBlank, 8);
 }
 
@@ -18,6 +18,9 @@
 #ifndef TIA_TIA
 #define TIA_TIA
 
+#include <bitset>
+#include <functional>
+
 #include "bspf.hxx"
 #include "Console.hxx"
 #include "Sound.hxx"
@@ -35,6 +38,7 @@
 #include "Missile.hxx"
 #include "Player.hxx"
 #include "Ball.hxx"
+#include "SpanMask.hxx"
 #include "LatchedInput.hxx"
 #include "PaddleReader.hxx"
 #include "DelayQueueIterator.hxx"
@@ -195,10 +199,48 @@ class TIA : public Device
     */
     void update();
 
+    /**
+      In logic-only mode, the TIA keeps all of its state (collisions, object
+      positions, frame timing) exact, but doesn't write to the framebuffer.
+      This is used for frames that are skipped anyway, ie. in fast-forward.
+    */
+    void setLogicOnly(bool logicOnly) { myLogicOnly = logicOnly; }
+
+    /**
+      While running ahead, frames are emulated and then undone by loading
+      an earlier state.  Those frames must not produce sound, and the
+      state must not replace the sound which is still being played, so
+      the sound is neither updated nor saved/loaded in that mode.
+    */
+    void setRunAhead(bool runAhead) { myRunAhead = runAhead; }
+
+    /**
+      Set a function which receives every write to the audio registers
+      (along with the system cycle), ie. for recording the sound.
+    */
+    using AudioWriteCallback = std::function<void(uInt16, uInt8, uInt64)>;
+    void setAudioWriteCallback(AudioWriteCallback callback) {
+      myAudioWriteCallback = callback;
+    }
+
     /**
       Returns a pointer to the internal frame buffer.
     */
     uInt8* frameBuffer() { return static_cast<uInt8*>(myFramebuffer); }
+    const uInt8* frameBuffer() const { return static_cast<const uInt8*>(myFramebuffer); }
+
+    /**
+      Answers which scanlines of the frame buffer changed since the last
+      call to clearDirtyLines(). Each completed frame is compared against
+      the previous one, so lines which only look different because they
+      were redrawn (or repeated by the line cache) are not reported.
+    */
+    bool isLineDirty(uInt32 y) const { return myDirtyLines[y]; }
+    bool hasDirtyLines() const { return myDirtyLines.any(); }
+    const std::bitset<TIAConstants::frameBufferHeight>& dirtyLines() const {
+      return myDirtyLines;
+    }
+    void clearDirtyLines() { myDirtyLines.reset(); }
 
     /**
       Answers dimensional info about the framebuffer.
@@ -491,6 +533,13 @@ class TIA : public Device
      */
     void cycle(uInt32 colorClocks);
 
+    /**
+     * The number of clocks (at most maxClocks) that can be processed as a
+     * single batch before the counter reaches hctrLimit or the next delayed
+     * write is due.
+     */
+    uInt32 batchLength(uInt32 maxClocks, uInt32 hctrLimit) const;
+
     /**
      * Advance the movement logic by a single clock.
      */
@@ -506,21 +555,45 @@ class TIA : public Device
      */
     void tickHframe();
 
+    /**
+     * Advance the given number of clocks during the visible part of the
+     * scanline in one go. No movement may be in progress, and no delayed
+     * writes may be due during the span.
+     */
+    void tickHframeSpan(uInt32 clocks);
+
     /**
      * Execute a RSYNC.
      */
     void applyRsync();
 
+    /**
+     * Are the pixels of the current line written to the framebuffer?
+     */
+    bool isDrawing() const { return !myLogicOnly && myFrameManager->isRendering(); }
+
     /**
      * Update the collision bitfield.
      */
     void updateCollision();
 
+    /**
+     * Update the collision bitfield for the span of clocks starting at x,
+     * given the pixels covered by each object (indexed by FixedObject).
+     */
+    void updateCollision(uInt32 x, uInt32 clocks, const SpanMask* coverage);
+
     /**
      * Render the current pixel into the framebuffer.
      */
     void renderPixel(uInt32 x, uInt32 y);
 
+    /**
+     * Render the span of pixels starting at x into the framebuffer, given the
+     * pixels covered by each object (indexed by FixedObject).
+     */
+    void renderSpan(uInt32 x, uInt32 clocks, uInt32 y, const SpanMask* coverage);
+
     /**
      * Clear the first 8 pixels of a scanline with black if we are in hblank
      * (called during HMOVE).
@@ -537,6 +610,17 @@ class TIA : public Device
      */
     void cloneLastLine();
 
+    /**
+     * Compare the completed frame against the previous one and mark the
+     * scanlines which changed.
+     */
+    void updateDirtyLines();
+
+    /**
+     * Mark all scanlines as changed, ie. after the frame buffer was replaced.
+     */
+    void invalidateLines();
+
     /**
      * Execute a delayed write. Called when the DelayQueue is pumped.
      */
@@ -637,6 +721,19 @@ class TIA : public Device
     // Pointer to the internal color-index-based frame buffer
     uInt8 myFramebuffer[160 * TIAConstants::frameBufferHeight];
 
+    // The frame buffer as of the last completed frame, and the scanlines
+    // which changed since the last call to clearDirtyLines()
+    uInt8 myLastFramebuffer[160 * TIAConstants::frameBufferHeight];
+    std::bitset<TIAConstants::frameBufferHeight> myDirtyLines;
+
+    // Whether myLastFramebuffer holds the last completed frame; if not, the
+    // next frame is taken over as a whole
+    bool myLastFramebufferValid;
+
+    // The scanlines which the line cache copied from the line above, in the
+    // current and in the last completed frame (see updateDirtyLines())
+    std::bitset<TIAConstants::frameBufferHeight> myClonedLines, myLastClonedLines;
+
     /**
      * Setting this to true injects random values into undefined reads.
      */
@@ -722,11 +819,9 @@ class TIA : public Device
     uInt8 myColorHBlank;
 
     /**
-     * The total number of color clocks since emulation started. This is a
-     * double a) to avoid overflows and b) as it will enter floating point
-     * expressions in the paddle readout simulation anyway.
+     * The total number of color clocks since emulation started.
      */
-    double myTimestamp;
+    uInt64 myTimestamp;
 
     /**
      * The "shadow registers" track the last written register value for the
@@ -747,6 +842,21 @@ class TIA : public Device
     bool myColorLossEnabled;
     bool myColorLossActive;
 
+    /**
+     * Skip all framebuffer writes (see setLogicOnly).
+     */
+    bool myLogicOnly;
+
+    /**
+     * Detach the sound (see setRunAhead).
+     */
+    bool myRunAhead;
+
+    /**
+     * Receives the audio register writes (see setAudioWriteCallback).
+     */
+    AudioWriteCallback myAudioWriteCallback;
+
     /**
      * System cycles at the end of the previous frame / beginning of next frame.
      */
@@ -102,6 +102,7 @@ VideoDialog::VideoDialog(OSystem& osystem, DialogContainer& parent,
   items.clear();
   VarList::push_back(items, "Sleep", "sleep");
   VarList::push_back(items, "Busy-wait", "busy");
+  VarList::push_back(items, "Hybrid", "hybrid");
   myFrameTiming = new PopUpWidget(myTab, font, xpos, ypos, pwidth, lineHeight,
                                   items, "Timing (*) ", lwidth);
   wid.push_back(myFrameTiming);
@@ -343,7 +344,7 @@ void VideoDialog::loadConfig()
 
   // Wait between frames
   myFrameTiming->setSelected(
-    instance().settings().getString("timing"), "sleep");
+    instance().settings().getString("timing"), "hybrid");
 
   // Aspect ratio setting (NTSC and PAL)
   myNAspectRatio->setValue(instance().settings().getInt("tia.aspectn"));
@@ -459,10 +460,20 @@ void VideoDialog::saveConfig()
   // Fast loading of Supercharger BIOS
   instance().settings().setValue("fastscbios", myFastSCBios->getState());
 
-  // Multi-threaded rendering
-  instance().settings().setValue("threads", myUseThreads->getState());
-  if(instance().hasConsole())
-    instance().frameBuffer().tiaSurface().ntsc().enableThreading(myUseThreads->getState());
+  // Multi-threaded rendering; the threads are only restarted when this
+  // actually changed
+  if(myUseThreads->getState() != instance().settings().getBool("threads"))
+  {
+    instance().settings().setValue("threads", myUseThreads->getState());
+    if(instance().hasConsole())
+    {
+      instance().frameBuffer().tiaSurface().invalidate();
+      instance().frameBuffer().tiaSurface().ntsc().enableThreading(
+          myUseThreads->getState(),
+          instance().settings().getInt("threadcount"),
+          instance().settings().getBool("threadaffinity"));
+    }
+  }
 
   // TV Mode
   instance().settings().setValue("tv.filter",
@@ -480,6 +491,7 @@ void VideoDialog::saveConfig()
   adj.artifacts   = myTVArtifacts->getValue();
   adj.fringing    = myTVFringe->getValue();
   adj.bleed       = myTVBleed->getValue();
+  instance().frameBuffer().tiaSurface().invalidate();
   instance().frameBuffer().tiaSurface().ntsc().setCustomAdjustables(adj);
 
   // TV phosphor mode
@@ -508,7 +520,7 @@ void VideoDialog::setDefaults()
       myRenderer->setSelectedIndex(0);
       myTIAZoom->setSelected("3", "");
       myTIAPalette->setSelected("standard", "");
-      myFrameTiming->setSelected("sleep", "");
+      myFrameTiming->setSelected("hybrid", "");
       myTIAInterpolate->setSelected("nearest", "");
       myNAspectRatio->setValue(90);
       myNAspectRatioLabel->setLabel("91");